@@ -1,12 +1,13 @@
 #pragma once
 
 #include <iostream>
-#include <fstream>
+#include <filesystem>
 
 #include <google/protobuf/io/coded_stream.h>
 #include <argparse/argparse.hpp>
 
 #include <csgopp/client.h>
+#include <csgopp/file.h>
 
 #include "common.h"
 
@@ -15,27 +16,8 @@ using csgopp::client::Client;
 using csgopp::client::GameEvent;
 using csgopp::client::User;
 using csgopp::client::Entity;
-
-struct AdvanceClient final : Client
-{
-    // Pack this in here since it's opaque in Python
-    std::ifstream file_stream;
-    IstreamInputStream file_input_stream;
-    CodedInputStream coded_input_stream;
-
-    explicit AdvanceClient(auto path)
-        : file_input_stream(&this->file_stream)
-        , coded_input_stream(&this->file_input_stream)
-    {
-        this->file_stream.open(path, std::ios::binary);
-        this->_header = csgopp::demo::Header(this->coded_input_stream);
-    }
-
-    bool advance()
-    {
-        return Client::advance(this->coded_input_stream);
-    }
-};
+using csgopp::common::read_ahead::ReadAheadInputStream;
+using csgopp::file::FileClient;
 
 struct AdvanceCommand
 {
@@ -46,6 +28,14 @@ struct AdvanceCommand
     {
         this->parser.add_description("advance through the demo to benchmark and check for errors");
         this->parser.add_argument("demo");
+        this->parser.add_argument("-r", "--read-ahead").help("read on a background thread instead of memory mapping").default_value(false).implicit_value(true);
+        this->parser.add_argument("-p", "--pipeline").help("split frames and parse entity messages on a separate thread").default_value(false).implicit_value(true);
+        this->parser.add_argument("-e", "--events-only").help("skip entity decoding and parse only events, users and string tables").default_value(false).implicit_value(true);
+        this->parser.add_argument("-i", "--inline-strings").help("store string properties in fixed buffers so entities are trivially copyable").default_value(false).implicit_value(true);
+        this->parser.add_argument("-l", "--change-log").help("log every property change and save the log to this path");
+        this->parser.add_argument("-s", "--schema-cache").help("directory to keep prioritized property orders in between runs");
+        this->parser.add_argument("--lazy-types").help("construct entity types only once an entity needs them").default_value(false).implicit_value(true);
+        this->parser.add_argument("-c", "--construction-threads").help("threads to construct entity types on, zero for all cores").default_value(1).scan<'i', int>();
         root.add_subparser(this->parser);
     }
 
@@ -63,7 +53,24 @@ struct AdvanceCommand
         {
             Timer client_timer;
 
-            AdvanceClient client(path);
+            csgopp::file::Options options;
+            options.read_ahead = this->parser.get<bool>("--read-ahead");
+            options.pipeline = this->parser.get<bool>("--pipeline");
+            FileClient<> client(path, options);
+            client.set_observes_entity_updates(false);
+            client.set_events_only(this->parser.get<bool>("--events-only"));
+            client.set_inline_strings(this->parser.get<bool>("--inline-strings"));
+            client.set_lazy_types(this->parser.get<bool>("--lazy-types"));
+            client.set_construction_threads(static_cast<size_t>(std::max(0, this->parser.get<int>("--construction-threads"))));
+            std::optional<std::string> change_log_path = this->parser.present("--change-log");
+            if (change_log_path.has_value())
+            {
+                client.set_change_log(std::make_shared<csgopp::client::change_log::ChangeLog>());
+            }
+            if (auto directory = this->parser.present("--schema-cache"))
+            {
+                client.set_schema_cache(std::make_shared<csgopp::client::schema_cache::SchemaCache>(directory.value()));
+            }
             while (client.advance());
 
             uint32_t frames = client.cursor();
@@ -82,8 +89,41 @@ struct AdvanceCommand
             std::cout << "frame_count: " << client.header().frame_count << std::endl;
             std::cout << "sign_on_size: " << client.header().sign_on_size << std::endl;
             std::cout << "advanced " << frames << " frames in " << ms << " ms (" << rate << " f/ms)" << std::endl;
+
+            if (auto* input = dynamic_cast<ReadAheadInputStream*>(&client.input()))
+            {
+                csgopp::common::read_ahead::Statistics statistics = input->statistics();
+                std::cout << "read ahead " << statistics.bytes << " bytes in " << statistics.depth
+                    << " buffers of " << statistics.buffer_size << " bytes, stalled "
+                    << statistics.stalls << " times for " << statistics.stall_nanoseconds / 1000000 << " ms" << std::endl;
+            }
+
+            if (const auto* pipeline = client.pipeline())
+            {
+                std::cout << "pipeline stalled " << pipeline->stalls() << " times" << std::endl;
+            }
+
+            if (const auto& cache = client.schema_cache())
+            {
+                std::cout << "schema cache " << (cache->statistics().disk_hits > 0 ? "hit" : "missed") << " on disk" << std::endl;
+            }
+
+            if (change_log_path.has_value())
+            {
+                client.change_log()->save(change_log_path.value());
+                std::cout << "logged " << client.change_log()->size() << " property changes in "
+                    << client.change_log()->bytes() << " bytes to " << change_log_path.value() << std::endl;
+            }
+
+            if (!client.events_only())
+            {
+                csgopp::client::entity_pool::Statistics statistics = client.entity_pool().statistics();
+                std::cout << "entity pool reused " << statistics.hits << " of " << statistics.hits + statistics.misses
+                    << " entities (" << statistics.hit_rate() * 100 << "%), retaining " << statistics.retained
+                    << " in " << statistics.bytes_retained << " bytes" << std::endl;
+            }
         }
-        catch (const csgopp::error::GameError& error)
+        catch (const csgopp::error::Error& error)
         {
             std::cerr << error.message() << std::endl;
             return -1;
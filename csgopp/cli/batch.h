@@ -0,0 +1,112 @@
+#pragma once
+
+#include <iomanip>
+#include <iostream>
+#include <filesystem>
+#include <thread>
+
+#include <argparse/argparse.hpp>
+
+#include <csgopp/batch.h>
+
+#include "common.h"
+
+using argparse::ArgumentParser;
+
+struct BatchCommand
+{
+    std::string name;
+    ArgumentParser parser;
+
+    explicit BatchCommand(ArgumentParser& root) : name("batch"), parser(name)
+    {
+        this->parser.add_description("advance through a directory or manifest of demos in parallel");
+        this->parser.add_argument("source").help("a directory of .dem files or a manifest with one path per line");
+        this->parser.add_argument("-t", "--threads").help("worker count, defaults to all cores").default_value(0).scan<'i', int>();
+        this->parser.add_argument("-m", "--memory").help("megabytes of demos in flight, defaults to no limit").default_value(0).scan<'i', int>();
+        this->parser.add_argument("-c", "--demo-cost").help("megabytes to charge each demo against --memory, defaults to its decompressed size").default_value(0).scan<'i', int>();
+        this->parser.add_argument("-s", "--scale").help("repeat with 1, 2, 4, ... threads and compare throughput").default_value(false).implicit_value(true);
+        root.add_subparser(this->parser);
+    }
+
+    [[nodiscard]] int main() const
+    {
+        Timer timer;
+        std::filesystem::path source = this->parser.get("source");
+        if (!std::filesystem::exists(source))
+        {
+            std::cerr << "No such file " << std::filesystem::absolute(source) << std::endl;
+            return -1;
+        }
+
+        std::vector<std::filesystem::path> paths;
+        try
+        {
+            paths = csgopp::batch::collect(source);
+        }
+        catch (const csgopp::error::Error& error)
+        {
+            std::cerr << error.message() << std::endl;
+            return -1;
+        }
+
+        csgopp::batch::Options options;
+        options.threads = static_cast<size_t>(std::max(0, this->parser.get<int>("--threads")));
+        options.memory = static_cast<size_t>(std::max(0, this->parser.get<int>("--memory"))) << 20;
+        options.demo_cost = static_cast<size_t>(std::max(0, this->parser.get<int>("--demo-cost"))) << 20;
+        options.observe_entity_updates = false;
+
+        std::vector<size_t> counts;
+        if (this->parser.get<bool>("--scale"))
+        {
+            size_t maximum = options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+            for (size_t count = 1; count < maximum; count *= 2)
+            {
+                counts.push_back(count);
+            }
+            counts.push_back(maximum);
+        }
+        else
+        {
+            counts.push_back(options.threads);
+        }
+
+        double baseline = 0;
+        csgopp::batch::Report report;
+        for (size_t count : counts)
+        {
+            options.threads = count;
+
+            // Each run starts cold so runs compare fairly
+            csgopp::client::schema_cache::SchemaCache::shared()->clear();
+            report = csgopp::batch::run(paths, options);
+            if (baseline == 0)
+            {
+                baseline = report.demos_per_second();
+            }
+
+            std::cout << std::fixed << std::setprecision(2)
+                << "threads: " << report.threads
+                << ", demos: " << report.results.size()
+                << ", seconds: " << report.seconds
+                << ", demos/s: " << report.demos_per_second()
+                << ", frames/s: " << report.frames_per_second()
+                << ", speedup: " << (baseline > 0 ? report.demos_per_second() / baseline : 0)
+                << ", steals: " << report.steals << std::endl;
+        }
+
+        for (const csgopp::batch::Result& result : report.results)
+        {
+            if (!result.ok)
+            {
+                std::cerr << result.path.string() << ": " << result.error << std::endl;
+            }
+        }
+
+        csgopp::client::schema_cache::Statistics schemas = csgopp::client::schema_cache::SchemaCache::shared()->statistics();
+        std::cout << "schemas built " << schemas.misses + schemas.disk_hits << " times, shared " << schemas.hits << " times" << std::endl;
+        std::cout << report.succeeded() << " succeeded, " << report.failed() << " failed" << std::endl;
+        std::cout << "finished in " << timer << std::endl;
+        return report.failed() > 0 ? 1 : 0;
+    }
+};
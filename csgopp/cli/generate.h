@@ -12,6 +12,7 @@
 #include <csgopp/client/data_table.h>
 #include <csgopp/client/server_class.h>
 #include <csgopp/client.h>
+#include <csgopp/file.h>
 
 #include "common.h"
 
@@ -24,8 +25,9 @@ using csgopp::client::DataTable;
 using csgopp::client::StringTable;
 using csgopp::client::GameEventType;
 using csgopp::client::Client;
+using csgopp::file::FileClient;
 
-struct GenerateClient final : public Client
+struct GenerateClient : public Client
 {
     size_t server_class_count = 0;
     size_t data_table_count = 0;
@@ -217,18 +219,14 @@ struct GenerateCommand
             return -1;
         }
 
-        std::ifstream file_stream(path, std::ios::binary);
-        IstreamInputStream file_input_stream(&file_stream);
-        CodedInputStream coded_input_stream(&file_input_stream);
-
         try
         {
-            GenerateClient client(coded_input_stream);
+            FileClient<GenerateClient> client(path);
             std::string network_protocol = std::to_string(client.header().network_protocol);
             std::cout << "found network protocol version " << network_protocol << std::endl;
 
             // Run simulation
-            while (client.advance(coded_input_stream));
+            while (client.advance());
 
             std::filesystem::path directory(std::filesystem::absolute(this->parser.present("-d").value_or(".")));
             std::string file(this->parser.present("-f").value_or(network_protocol));
@@ -245,7 +243,7 @@ struct GenerateCommand
                 this->write_layout(directory / (file + ".layout.txt"), client);
             }
         }
-        catch (const csgopp::error::GameError& error)
+        catch (const csgopp::error::Error& error)
         {
             std::cerr << error.message() << std::endl;
             return -1;
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <iostream>
+#include <filesystem>
+#include <map>
+
+#include <argparse/argparse.hpp>
+
+#include <csgopp/demo.h>
+#include <csgopp/demo/frame_index.h>
+
+#include "common.h"
+
+using argparse::ArgumentParser;
+using csgopp::demo::describe_command;
+using csgopp::demo::frame_index::Frame;
+using csgopp::demo::frame_index::FrameIndex;
+
+struct IndexCommand
+{
+    std::string name;
+    ArgumentParser parser;
+
+    explicit IndexCommand(ArgumentParser& root) : name("index"), parser(name)
+    {
+        this->parser.add_description("scan frame offsets and write a sidecar index next to the demo");
+        this->parser.add_argument("demo");
+        this->parser.add_argument("-o", "--output").help("index path, defaults to <demo>.index");
+        this->parser.add_argument("-p", "--print").help("print every frame").default_value(false).implicit_value(true);
+        root.add_subparser(this->parser);
+    }
+
+    [[nodiscard]] int main() const
+    {
+        Timer timer;
+        std::filesystem::path path = this->parser.get("demo");
+        if (!std::filesystem::exists(path))
+        {
+            std::cerr << "No such file " << std::filesystem::absolute(path) << std::endl;
+            return -1;
+        }
+
+        std::filesystem::path output = FrameIndex::sidecar(path);
+        if (auto argument = this->parser.present("--output"))
+        {
+            output = argument.value();
+        }
+
+        try
+        {
+            FrameIndex index = FrameIndex::scan(path);
+            index.save(output);
+
+            std::map<csgopp::demo::Command::Type, size_t> counts;
+            for (const Frame& frame : index.frames())
+            {
+                counts[frame.command] += 1;
+                if (this->parser.get<bool>("--print"))
+                {
+                    std::cout << frame.offset << " " << frame.tick << " "
+                        << describe_command(frame.command) << " " << frame.size << std::endl;
+                }
+            }
+
+            for (const auto& [command, count] : counts)
+            {
+                std::cout << describe_command(command) << ": " << count << std::endl;
+            }
+            std::cout << "indexed " << index.size() << " frames to " << output << std::endl;
+        }
+        catch (const csgopp::error::Error& error)
+        {
+            std::cerr << error.message() << std::endl;
+            return -1;
+        }
+
+        std::cout << "finished in " << timer << std::endl;
+        return 0;
+    }
+};
@@ -6,6 +6,9 @@
 #include "generate.h"
 #include "advance.h"
 #include "summary.h"
+#include "index.h"
+#include "batch.h"
+#include "probe.h"
 
 using argparse::ArgumentParser;
 
@@ -17,6 +20,9 @@ int main(int argc, char** argv)
     GenerateCommand generate(parser);
     AdvanceCommand advance(parser);
     SummaryCommand summary(parser);
+    IndexCommand index(parser);
+    BatchCommand batch(parser);
+    ProbeCommand probe(parser);
 
     try
     {
@@ -40,6 +46,18 @@ int main(int argc, char** argv)
     {
         return summary.main();
     }
+    else if (parser.is_subcommand_used(index.name))
+    {
+        return index.main();
+    }
+    else if (parser.is_subcommand_used(batch.name))
+    {
+        return batch.main();
+    }
+    else if (parser.is_subcommand_used(probe.name))
+    {
+        return probe.main();
+    }
     else
     {
         std::cerr << "Expected a subcommand." << HELP << std::endl;
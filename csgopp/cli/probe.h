@@ -0,0 +1,111 @@
+#pragma once
+
+#include <iostream>
+#include <filesystem>
+#include <map>
+
+#include <argparse/argparse.hpp>
+
+#include <csgopp/batch.h>
+#include <csgopp/probe.h>
+
+#include "common.h"
+
+using argparse::ArgumentParser;
+using csgopp::probe::Probe;
+
+struct ProbeCommand
+{
+    std::string name;
+    ArgumentParser parser;
+
+    explicit ProbeCommand(ArgumentParser& root) : name("probe"), parser(name)
+    {
+        this->parser.add_description("print header, server info and sign-on players without parsing the match");
+        this->parser.add_argument("demos").help("demos or directories of demos").nargs(argparse::nargs_pattern::at_least_one);
+        this->parser.add_argument("-t", "--threads").help("worker count, defaults to all cores").default_value(0).scan<'i', int>();
+        this->parser.add_argument("-p", "--players").help("list the players of each demo").default_value(false).implicit_value(true);
+        root.add_subparser(this->parser);
+    }
+
+    [[nodiscard]] int main() const
+    {
+        Timer timer;
+        std::vector<std::filesystem::path> paths;
+        for (const std::string& argument : this->parser.get<std::vector<std::string>>("demos"))
+        {
+            std::filesystem::path path(argument);
+            if (std::filesystem::is_directory(path))
+            {
+                std::vector<std::filesystem::path> found = csgopp::batch::collect(path);
+                paths.insert(paths.end(), found.begin(), found.end());
+            }
+            else if (std::filesystem::exists(path))
+            {
+                paths.push_back(path);
+            }
+            else
+            {
+                std::cerr << "No such file " << std::filesystem::absolute(path) << std::endl;
+                return -1;
+            }
+        }
+
+        // Results are indexed by path since workers finish out of order
+        std::vector<Probe> probes(paths.size());
+        std::map<std::filesystem::path, size_t> indices;
+        for (size_t i = 0; i < paths.size(); ++i)
+        {
+            indices.emplace(paths[i], i);
+        }
+
+        csgopp::batch::Options options;
+        options.threads = static_cast<size_t>(std::max(0, this->parser.get<int>("--threads")));
+        csgopp::batch::Report report = csgopp::batch::schedule(paths, options, [&](
+            const std::filesystem::path& path,
+            csgopp::batch::Result& result)
+        {
+            Probe& probe = probes[indices.at(path)];
+            probe = csgopp::probe::probe(path);
+            result.frames = probe.frames;
+            result.ticks = probe.header.tick_count;
+        });
+
+        bool players = this->parser.get<bool>("--players");
+        for (size_t i = 0; i < paths.size(); ++i)
+        {
+            const csgopp::batch::Result& result = report.results[i];
+            if (!result.ok)
+            {
+                std::cerr << result.path.string() << ": " << result.error << std::endl;
+                continue;
+            }
+
+            const Probe& probe = probes[i];
+            std::cout << result.path.string()
+                << "\tmap: " << probe.header.map_name
+                << "\tserver: " << probe.header.server_name
+                << "\tticks: " << probe.header.tick_count
+                << "\tseconds: " << probe.header.playback_time;
+            if (probe.has_server_info)
+            {
+                std::cout << "\ttick_interval: " << probe.server_info.tick_interval()
+                    << "\tmax_clients: " << probe.server_info.max_clients();
+            }
+            std::cout << "\tusers: " << probe.users.size()
+                << "\tgame_events: " << probe.game_event_types.size() << std::endl;
+
+            if (players)
+            {
+                for (const auto& user : probe.users)
+                {
+                    std::cout << "  " << user->id << " " << user->xuid << " " << user->name
+                        << (user->is_fake ? " (bot)" : "") << (user->is_hltv ? " (hltv)" : "") << std::endl;
+                }
+            }
+        }
+
+        std::cout << "probed " << report.succeeded() << " demos, " << report.failed() << " failed, in " << timer << std::endl;
+        return report.failed() > 0 ? 1 : 0;
+    }
+};
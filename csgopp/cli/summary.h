@@ -1,13 +1,13 @@
 #pragma once
 
 #include <iostream>
-#include <fstream>
 #include <filesystem>
 
 #include <google/protobuf/io/coded_stream.h>
 #include <argparse/argparse.hpp>
 
 #include <csgopp/client.h>
+#include <csgopp/file.h>
 #include <object/object.h>
 
 #include "common.h"
@@ -19,6 +19,8 @@ using csgopp::client::GameEvent;
 using csgopp::client::entity::EntityType;
 using csgopp::client::entity::EntityDatum;
 using csgopp::client::entity::EntityConstReference;
+using csgopp::client::entity::EntityMask;
+using csgopp::file::FileClient;
 using object::Accessor;
 using object::ConstReference;
 
@@ -126,20 +128,22 @@ const char* describe_weapon(uint32_t weapon)
     }
 }
 
-struct SummaryClient final : public Client
+struct SummaryClient : public Client
 {
     using Client::Client;
 
     std::shared_ptr<const ServerClass> player_server_class;
-    Accessor weapon_purchases_accessor;
+    EntityMask weapon_purchases_mask;
 
     void on_server_class_creation(const std::shared_ptr<const ServerClass>& server_class) override
     {
         if (server_class->name == "CCSPlayer")
         {
             this->player_server_class = server_class;
-            auto type = server_class->data_table->type();
-            this->weapon_purchases_accessor = Accessor(type)["cslocaldata"]["m_iWeaponPurchasesThisRound"];
+            // Built on demand in case the client constructs types lazily
+            auto type = server_class->data_table->construct_type();
+            Accessor weapon_purchases = Accessor(type)["cslocaldata"]["m_iWeaponPurchasesThisRound"];
+            this->weapon_purchases_mask = EntityMask::of(*type, weapon_purchases);
         }
     }
 
@@ -148,13 +152,13 @@ struct SummaryClient final : public Client
         const std::vector<uint16_t>& indices
     ) override
     {
-        if (entity->server_class == this->player_server_class)
+        if (entity->server_class == this->player_server_class && entity->changed(this->weapon_purchases_mask, this->tick()))
         {
             for (uint16_t index : indices)
             {
-                EntityConstReference ref = entity->at(index);
-                if (this->weapon_purchases_accessor.is_strict_superset_of(ref))
+                if (this->weapon_purchases_mask.test(index))
                 {
+                    EntityConstReference ref = entity->at(index);
                     const std::shared_ptr<const User>& user = this->users().at_index(entity->id);
                     OK(user != nullptr);
                     int weapon = atoi(ref.property->name.c_str());
@@ -233,16 +237,12 @@ struct SummaryCommand
             return -1;
         }
 
-        std::ifstream file_stream(path, std::ios::binary);
-        IstreamInputStream file_input_stream(&file_stream);
-        CodedInputStream coded_input_stream(&file_input_stream);
-
         try
         {
-            SummaryClient client(coded_input_stream);
-            while (client.advance(coded_input_stream));
+            FileClient<SummaryClient> client(path);
+            while (client.advance());
         }
-        catch (const csgopp::error::GameError& error)
+        catch (const csgopp::error::Error& error)
         {
             std::cerr << error.message() << std::endl;
             return -1;
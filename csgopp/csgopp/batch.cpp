@@ -0,0 +1,159 @@
+#include "batch.h"
+#include "common/compression.h"
+#include "common/pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+namespace csgopp::batch
+{
+
+using csgopp::common::pool::Budget;
+using csgopp::common::pool::Pool;
+using csgopp::common::pool::Reservation;
+
+size_t Report::succeeded() const
+{
+    return std::count_if(this->results.begin(), this->results.end(), [](const Result& result)
+    {
+        return result.ok;
+    });
+}
+
+size_t Report::failed() const
+{
+    return this->results.size() - this->succeeded();
+}
+
+uint64_t Report::frames() const
+{
+    uint64_t frames = 0;
+    for (const Result& result : this->results)
+    {
+        frames += result.frames;
+    }
+    return frames;
+}
+
+double Report::demos_per_second() const
+{
+    return this->seconds > 0 ? static_cast<double>(this->results.size()) / this->seconds : 0;
+}
+
+double Report::frames_per_second() const
+{
+    return this->seconds > 0 ? static_cast<double>(this->frames()) / this->seconds : 0;
+}
+
+static bool is_demo(const std::filesystem::path& path)
+{
+    std::filesystem::path extension = path.extension();
+    if (extension == ".gz" || extension == ".zst" || extension == ".bz2")
+    {
+        extension = path.stem().extension();
+    }
+    return extension == ".dem";
+}
+
+std::vector<std::filesystem::path> collect(const std::filesystem::path& source)
+{
+    std::vector<std::filesystem::path> paths;
+    if (std::filesystem::is_directory(source))
+    {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(source))
+        {
+            if (entry.is_regular_file() && is_demo(entry.path()))
+            {
+                paths.push_back(entry.path());
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+        return paths;
+    }
+
+    std::ifstream manifest(source);
+    if (!manifest)
+    {
+        throw csgopp::error::Error("failed to open manifest " + source.string());
+    }
+
+    std::string line;
+    while (std::getline(manifest, line))
+    {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' '))
+        {
+            line.pop_back();
+        }
+        if (line.empty() || line.front() == '#')
+        {
+            continue;
+        }
+
+        std::filesystem::path path(line);
+        paths.push_back(path.is_relative() ? source.parent_path() / path : path);
+    }
+
+    return paths;
+}
+
+Report schedule(const std::vector<std::filesystem::path>& paths, const Options& options, const Parse& parse)
+{
+    using Clock = std::chrono::steady_clock;
+
+    Report report;
+    report.results.resize(paths.size());
+
+    Budget budget(options.memory > 0 ? options.memory : SIZE_MAX);
+    auto start = Clock::now();
+
+    {
+        Pool pool(options.threads);
+        report.threads = pool.size();
+
+        for (size_t i = 0; i < paths.size(); ++i)
+        {
+            pool.submit([&, i]()
+            {
+                Result& result = report.results[i];
+                result.path = paths[i];
+
+                auto begin = Clock::now();
+                try
+                {
+                    size_t cost = 0;
+                    if (options.memory > 0)
+                    {
+                        cost = options.demo_cost > 0 ? options.demo_cost : csgopp::common::compression::estimate_size(paths[i]);
+                    }
+                    Reservation reservation(budget, cost);
+                    begin = Clock::now();
+
+                    parse(paths[i], result);
+                    result.ok = true;
+                }
+                catch (const csgopp::error::Error& error)
+                {
+                    result.error = error.message();
+                }
+                catch (const std::exception& error)
+                {
+                    result.error = error.what();
+                }
+                catch (...)
+                {
+                    result.error = "unknown error";
+                }
+                result.seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+            });
+        }
+
+        pool.wait();
+        report.steals = pool.steals();
+    }
+
+    report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return report;
+}
+
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "client.h"
+#include "file.h"
+
+/// Parsing many demos at once.
+///
+/// Demos are scheduled on a work-stealing pool with a single client alive
+/// per worker at any time. An optional memory budget bounds the estimated
+/// cost of the demos in flight across all workers, and per-demo outcomes
+/// (including errors) are aggregated into a `Report`.
+namespace csgopp::batch
+{
+
+using csgopp::client::Client;
+using csgopp::file::FileClient;
+
+/// \brief The outcome of parsing a single demo.
+struct Result
+{
+    std::filesystem::path path;
+    bool ok{false};
+    std::string error;
+    uint32_t frames{};
+    uint32_t ticks{};
+    double seconds{};
+};
+
+/// \brief The aggregate outcome of a batch.
+struct Report
+{
+    std::vector<Result> results;
+    size_t threads{};
+    size_t steals{};
+    double seconds{};
+
+    [[nodiscard]] size_t succeeded() const;
+    [[nodiscard]] size_t failed() const;
+    [[nodiscard]] uint64_t frames() const;
+    [[nodiscard]] double demos_per_second() const;
+    [[nodiscard]] double frames_per_second() const;
+};
+
+struct Options
+{
+    /// Worker count, zero for the hardware count.
+    size_t threads{0};
+    /// Bytes allowed in flight, zero for no limit. Each demo is charged
+    /// `demo_cost`, or if that is zero its estimated decompressed size,
+    /// which client state for the demo roughly scales with.
+    size_t memory{0};
+    /// Bytes to charge per demo, zero to estimate from each demo.
+    size_t demo_cost{0};
+    /// Share one copy of each schema between workers through
+    /// `SchemaCache::shared`, rather than building it per demo.
+    bool share_schemas{true};
+    /// Call the entity update hooks. Turn this off when `T` doesn't
+    /// override them to save two virtual calls per update.
+    bool observe_entity_updates{true};
+};
+
+/// \brief Gather the demos named by a directory or manifest.
+///
+/// Directories are searched recursively for `.dem` files, including ones
+/// compressed as `.dem.gz`, `.dem.zst` or `.dem.bz2`. Any other file
+/// is read as a manifest with one path per line; blank lines and lines
+/// starting with `#` are ignored, and relative paths are resolved against
+/// the manifest's directory.
+///
+/// \param source a directory or manifest file.
+/// \return the demo paths in a stable order.
+std::vector<std::filesystem::path> collect(const std::filesystem::path& source);
+
+/// \brief Parse a single demo into a result on the calling thread.
+using Parse = std::function<void(const std::filesystem::path&, Result&)>;
+
+/// \brief Run a parse function over every demo on the pool.
+///
+/// Anything thrown by `parse` is caught and recorded in the demo's result.
+Report schedule(const std::vector<std::filesystem::path>& paths, const Options& options, const Parse& parse);
+
+/// \brief Advance a client of type `T` through every demo.
+///
+/// \tparam T the client to construct for each demo.
+/// \param finish called on the worker with the exhausted client so that
+///     observers can extract their output into shared state.
+template<typename T = Client>
+Report run(
+    const std::vector<std::filesystem::path>& paths,
+    const Options& options,
+    const std::function<void(FileClient<T>&, Result&)>& finish = {})
+{
+    return schedule(paths, options, [&options, &finish](const std::filesystem::path& path, Result& result)
+    {
+        FileClient<T> client(path);
+        client.set_observes_entity_updates(options.observe_entity_updates);
+        if (options.share_schemas)
+        {
+            client.set_schema_cache(csgopp::client::schema_cache::SchemaCache::shared());
+        }
+        while (client.advance());
+        result.frames = client.cursor();
+        result.ticks = client.tick();
+        if (finish)
+        {
+            finish(client, result);
+        }
+    });
+}
+
+}
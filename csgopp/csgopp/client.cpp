@@ -1,9 +1,17 @@
 #include "client.h"
 
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
 namespace csgopp::client
 {
 
 using csgo::message::net::CSVCMsg_SendTable_sendprop_t;
+using csgopp::client::checkpoint::CheckpointError;
+using csgopp::client::checkpoint::Reader;
+using csgopp::client::checkpoint::Writer;
+using csgopp::client::data_table::PrioritizedOrders;
+using csgopp::client::server_class::construct_types;
+using google::protobuf::io::ArrayInputStream;
 
 constexpr size_t MAX_EDICT_BITS = 11;
 constexpr size_t ENTITY_HANDLE_INDEX_MASK = (1 << MAX_EDICT_BITS) - 1;
@@ -19,9 +27,41 @@ Client::Client(Header header) : _header(header)
 {
 }
 
+const Client::EntityDatabase& Client::entities() const
+{
+    if (this->_events_only)
+    {
+        throw GameError("entities are not decoded in events-only mode");
+    }
+    return this->_entities;
+}
+
+void Client::set_packet_filter(const PacketFilter& filter)
+{
+    this->_packet_filter = filter | PacketFilter::required();
+    if (this->_events_only)
+    {
+        this->_packet_filter.disable(csgo::message::net::SVC_Messages::svc_PacketEntities);
+    }
+}
+
+void Client::set_events_only(bool events_only)
+{
+    this->_events_only = events_only;
+    this->set_packet_filter(this->_packet_filter);
+}
+
+void Client::set_inline_strings(bool inline_strings)
+{
+    if (this->_data_tables.size() > 0)
+    {
+        throw csgopp::error::Error("inline strings must be set before data tables are parsed");
+    }
+    this->_inline_strings = inline_strings;
+}
+
 bool Client::advance(CodedInputStream& stream)
 {
-    bool ok = true;
     this->before_frame();
 
     char command;
@@ -29,6 +69,36 @@ bool Client::advance(CodedInputStream& stream)
     VERIFY(stream.ReadLittleEndian32(&this->_tick));
     VERIFY(stream.Skip(1));  // player slot
 
+    bool ok = this->advance_command(stream, command);
+    this->_finish_frame(command, ok, stream.CurrentPosition());
+    return ok;
+}
+
+bool Client::advance(Frame& frame)
+{
+    this->before_frame();
+    this->_tick = frame.tick;
+
+    bool ok = true;
+    if (frame.command == demo::Command::SIGN_ON || frame.command == demo::Command::PACKET)
+    {
+        for (Message& message : frame.messages)
+        {
+            this->_advance_message(message);
+        }
+    }
+    else
+    {
+        CodedInputStream stream(reinterpret_cast<const uint8_t*>(frame.data.data()), static_cast<int>(frame.data.size()));
+        ok = this->advance_command(stream, static_cast<char>(frame.command));
+    }
+
+    this->_finish_frame(static_cast<char>(frame.command), ok, frame.end);
+    return ok;
+}
+
+bool Client::advance_command(CodedInputStream& stream, char command)
+{
     switch (command)
     {
         case demo::Command::SIGN_ON:
@@ -47,8 +117,7 @@ bool Client::advance(CodedInputStream& stream)
             this->advance_data_tables(stream);
             break;
         case demo::Command::STOP:
-            ok = false;
-            break;
+            return false;
         case demo::Command::CUSTOM_DATA:
             this->advance_custom_data(stream);
             break;
@@ -59,16 +128,48 @@ bool Client::advance(CodedInputStream& stream)
             this->advance_unknown(stream, command);
             break;
     }
+    return true;
+}
 
+void Client::_finish_frame(char command, bool ok, int64_t position)
+{
     this->_cursor += 1;
     this->on_frame(command);
-    return ok;
+
+    // Only checkpoint once there's a schema to restore entities against
+    if (ok && this->_checkpoint_interval > 0 && this->_server_classes.size() > 0)
+    {
+        if (this->_checkpoints.empty() || this->_tick >= this->_checkpoints.back().tick + this->_checkpoint_interval)
+        {
+            this->_checkpoints.emplace(this->checkpoint(position));
+        }
+    }
+}
+
+void Client::_advance_message(Message& message)
+{
+    if (message.entities == nullptr)
+    {
+        CodedInputStream stream(reinterpret_cast<const uint8_t*>(message.data.data()), static_cast<int>(message.data.size()));
+        this->advance_packet(stream);
+        return;
+    }
+
+    // Mirrors advance_packet for messages parsed by the pipeline
+    if (!this->_packet_filter.test(message.command))
+    {
+        return;
+    }
+
+    this->before_packet(message.command);
+    this->advance_packet_packet_entities(*message.entities);
+    this->on_packet(message.command);
 }
 
 void Client::advance_packets(CodedInputStream& stream)
 {
     // Arbitrary player data, seems useless
-    VERIFY(stream.Skip(152 + 4 + 4));
+    VERIFY(stream.Skip(demo::PACKET_INFO_SIZE));
 
     uint32_t size;
     VERIFY(stream.ReadLittleEndian32(&size));
@@ -83,9 +184,22 @@ void Client::advance_packets(CodedInputStream& stream)
     stream.PopLimit(limit);
 }
 
+inline void advance_packet_skip(CodedInputStream& stream)
+{
+    uint32_t size;
+    OK(stream.ReadVarint32(&size));
+    OK(stream.Skip(static_cast<int32_t>(size)));
+}
+
 void Client::advance_packet(CodedInputStream& stream)
 {
     uint32_t command = stream.ReadTag();
+    if (!this->_packet_filter.test(command))
+    {
+        advance_packet_skip(stream);
+        return;
+    }
+
     this->before_packet(command);
 
     switch (command)
@@ -231,12 +345,18 @@ void Client::advance_data_tables(CodedInputStream& stream)
 {
     uint32_t size;
     VERIFY(stream.ReadLittleEndian32(&size));
-    CodedInputStream::Limit limit = stream.PushLimit(size);
+    std::string data;
+    VERIFY(stream.ReadString(&data, static_cast<int>(size)));
+    this->_schema_hash = csgopp::common::hash::fnv1a(data, this->_schema_hash);
 
-    this->create_data_tables_and_server_classes(stream);
+    // Cached schemas are complete, so they can't extend existing tables
+    if (this->_schema_cache != nullptr && this->_data_tables.size() == 0)
+    {
+        this->create_schema(data);
+        return;
+    }
 
-    VERIFY(stream.BytesUntilLimit() == 0);
-    stream.PopLimit(limit);
+    this->create_data_tables_and_server_classes(data);
 }
 
 /// \see https://github.com/markus-wa/demoinfocs-golang/blob/50f55785b7a0ba89164662a000e00cd55969f7ae/pkg/demoinfocs/stringtables.go#L66
@@ -289,6 +409,7 @@ void Client::advance_string_tables(CodedInputStream& stream)
         this->on_string_table_creation(string_table);
     }
 
+    this->_baselines.clear();
     VERIFY(stream.BytesUntilLimit() == 0);
     stream.PopLimit(limit);
 }
@@ -303,13 +424,6 @@ bool Client::advance_unknown(CodedInputStream& stream, char command)
     throw GameError("encountered unknown command " + std::to_string(command));
 }
 
-inline void advance_packet_skip(CodedInputStream& stream)
-{
-    uint32_t size;
-    OK(stream.ReadVarint32(&size));
-    OK(stream.Skip(static_cast<int32_t>(size)));
-}
-
 void Client::advance_packet_nop(CodedInputStream& stream)
 {
     advance_packet_skip(stream);
@@ -437,7 +551,7 @@ DatabaseWithName<DataTable> Client::create_data_tables(CodedInputStream& stream)
                         property = std::make_unique<DataTable::Vector2Property>(std::move(property_data));
                         break;
                     case Kind::STRING:
-                        property = std::make_unique<DataTable::StringProperty>(std::move(property_data));
+                        property = std::make_unique<DataTable::StringProperty>(std::move(property_data), this->_inline_strings);
                         break;
                     case Kind::ARRAY:
                         VERIFY(preceding_array_element != nullptr);
@@ -570,15 +684,64 @@ Database<ServerClass> Client::create_server_classes(
     return new_server_classes;
 }
 
-void Client::create_data_tables_and_server_classes(CodedInputStream& stream)
+void Client::create_data_tables_and_server_classes(const std::string& data)
 {
+    ArrayInputStream input(data.data(), static_cast<int>(data.size()));
+    CodedInputStream stream(&input);
     DatabaseWithName<DataTable> new_data_tables = this->create_data_tables(stream);
     Database<ServerClass> new_server_classes = this->create_server_classes(stream, new_data_tables);
+    VERIFY(stream.CurrentPosition() == static_cast<int>(data.size()));
 
-    // Materialize types
-    for (const std::shared_ptr<ServerClass>& server_class : new_server_classes)
+    // Materialize types, unless no entity will need them
+    if (!this->_lazy_types && !this->_events_only)
+    {
+        construct_types(new_server_classes, nullptr, this->_construction_threads);
+    }
+
+    this->emplace_schema(new_data_tables, new_server_classes);
+}
+
+void Client::create_schema(const std::string& data)
+{
+    // The first send tables, so the chained hash is theirs alone
+    this->_schema = this->_schema_cache->get(
+        this->_schema_hash,
+        this->_inline_strings,
+        [this, &data](Schema& schema, const PrioritizedOrders* orders)
+        {
+            ArrayInputStream input(data.data(), static_cast<int>(data.size()));
+            CodedInputStream stream(&input);
+            schema.data_tables = this->create_data_tables(stream);
+            schema.server_classes = this->create_server_classes(stream, schema.data_tables);
+            VERIFY(stream.CurrentPosition() == static_cast<int>(data.size()));
+
+            if (!this->_lazy_types && !this->_events_only)
+            {
+                construct_types(schema.server_classes, orders, this->_construction_threads);
+            }
+        }
+    );
+
+    // A lazy or events-only client may have built the schema without every type
+    if (!this->_lazy_types && !this->_events_only)
+    {
+        for (const std::shared_ptr<ServerClass>& server_class : this->_schema->server_classes)
+        {
+            this->_construct_type(*server_class);
+        }
+    }
+
+    this->emplace_schema(this->_schema->data_tables, this->_schema->server_classes);
+}
+
+void Client::emplace_schema(const DataTableDatabase& new_data_tables, const Database<ServerClass>& new_server_classes)
+{
+    // Baselines and pooled entities belong to the old types
+    this->_baselines.clear();
+    this->_entity_pool->clear();
+    if (this->_history != nullptr)
     {
-        server_class->data_table->construct_type();
+        this->_history->clear(this->_tick);
     }
 
     // Now we can emplace and emit
@@ -597,17 +760,88 @@ void Client::create_data_tables_and_server_classes(CodedInputStream& stream)
         this->_server_classes.emplace(server_class->index, std::shared_ptr(server_class));
         this->on_server_class_creation(server_class);
     }
+
+    this->_bind_column_stores();
 }
 
-void Client::advance_packet_send_table(CodedInputStream& stream)
+void Client::set_history(uint32_t ticks, size_t budget)
 {
-    CodedInputStream::Limit limit = stream.ReadLengthAndPushLimit();
-    VERIFY(limit != 0);
+    this->_history = ticks > 0 ? std::make_unique<History>(this->_entity_pool, this->_tick, ticks, budget) : nullptr;
+}
 
-    this->create_data_tables_and_server_classes(stream);
+std::shared_ptr<const Entity> Client::entity_at(Entity::Id id, uint32_t tick) const
+{
+    if (this->_history == nullptr)
+    {
+        throw csgopp::client::history::HistoryError("entity history is disabled");
+    }
 
-    VERIFY(stream.BytesUntilLimit() == 0);
-    stream.PopLimit(limit);
+    std::optional<std::shared_ptr<const Entity>> before = this->_history->find(id, tick);
+    return before.has_value() ? std::move(*before) : this->_entities.get(id);
+}
+
+std::shared_ptr<const ColumnStore> Client::track_columns(std::string server_class, std::vector<std::string> properties)
+{
+    auto store = std::make_shared<ColumnStore>(std::move(server_class), std::move(properties));
+    this->_column_stores.emplace_back(store);
+    this->_bind_column_store(store);
+    return store;
+}
+
+void Client::_bind_column_stores()
+{
+    this->_column_stores_by_class.assign(this->_server_classes.size(), {});
+    for (const std::shared_ptr<ColumnStore>& store : this->_column_stores)
+    {
+        this->_bind_column_store(store);
+    }
+}
+
+void Client::_bind_column_store(const std::shared_ptr<ColumnStore>& store)
+{
+    auto iterator = this->_server_classes.by_name.find(store->server_class_name());
+    if (iterator == this->_server_classes.by_name.end())
+    {
+        return;
+    }
+
+    const std::shared_ptr<ServerClass>& server_class = iterator->second;
+    this->_construct_type(*server_class);
+    store->bind(server_class);
+    if (this->_column_stores_by_class.size() < this->_server_classes.size())
+    {
+        this->_column_stores_by_class.resize(this->_server_classes.size());
+    }
+    this->_column_stores_by_class.at(server_class->index).emplace_back(store.get());
+
+    // Seed the store with entities that already exist
+    for (const std::shared_ptr<Entity>& entity : this->_entities)
+    {
+        if (entity != nullptr && entity->server_class == server_class)
+        {
+            store->assign(*entity);
+        }
+    }
+}
+
+std::span<ColumnStore* const> Client::_column_stores_of(const ServerClass& server_class) const
+{
+    if (server_class.index < this->_column_stores_by_class.size())
+    {
+        return this->_column_stores_by_class[server_class.index];
+    }
+    return {};
+}
+
+void Client::advance_packet_send_table(CodedInputStream& stream)
+{
+    uint32_t size;
+    VERIFY(stream.ReadVarint32(&size));
+    std::string data;
+    VERIFY(stream.ReadString(&data, static_cast<int>(size)));
+    this->_schema_hash = csgopp::common::hash::fnv1a(data, this->_schema_hash);
+
+    this->create_data_tables_and_server_classes(data);
 }
 
 void Client::advance_packet_class_info(CodedInputStream& stream)
@@ -665,6 +899,11 @@ void Client::populate_string_table(
     int32_t count
 )
 {
+    if (string_table.name == "instancebaseline")
+    {
+        this->_baselines.clear();
+    }
+
     BitStream string_data(blob);
     uint8_t verification_bit;
     string_data.read(&verification_bit, 1);
@@ -848,7 +1087,14 @@ void Client::advance_packet_packet_entities(CodedInputStream& stream)
     DEBUG(int current_position = stream.CurrentPosition());
     csgo::message::net::CSVCMsg_PacketEntities data;
     VERIFY(data.ParseFromCodedStream(&stream));
+    this->advance_packet_packet_entities(data);
 
+    VERIFY(stream.BytesUntilLimit() == 0);
+    stream.PopLimit(limit);
+}
+
+void Client::advance_packet_packet_entities(const csgo::message::net::CSVCMsg_PacketEntities& data)
+{
     BitStream entity_data(data.entity_data());
     Entity::Id entity_id = 0;
     for (uint32_t i = 0; i < data.updated_entries(); ++i, ++entity_id)
@@ -879,9 +1125,6 @@ void Client::advance_packet_packet_entities(CodedInputStream& stream)
             }
         }
     }
-
-    VERIFY(stream.BytesUntilLimit() == 0);
-    stream.PopLimit(limit);
 }
 
 // THIS MUST BE CALLED BEFORE _update_entity
@@ -893,47 +1136,18 @@ void Client::_get_update_indices(BitStream& stream)
     // Keeping this static GREATLY reduces the number of spurious allocations
     this->_update_entity_indices.clear();
 
-    // It's honestly probably more efficient to read through this twice than it is to allocate and make copies
+    // Indices all precede the values they index, so they can't be decoded in the same pass
     uint16_t index = 0;
     while (true)
     {
         uint16_t jump;
-        if (small_increment_optimization)
-        {
-            uint8_t use_auto_index;
-            VERIFY(stream.read(&use_auto_index, 1));
-            if (use_auto_index)
-            {
-                jump = 0;
-            }
-            else
-            {
-                uint8_t is_small_jump;
-                VERIFY(stream.read(&is_small_jump, 1));
-                if (is_small_jump)
-                {
-                    VERIFY(stream.read(&jump, 3));
-                }
-                else
-                {
-                    VERIFY(stream.read_compressed_uint16(&jump));
-                }
-            }
-        }
-        else
-        {
-            VERIFY(stream.read_compressed_uint16(&jump));
-        }
-
+        VERIFY(stream.read_property_jump(small_increment_optimization, &jump));
         if (jump == 0xFFF)
         {
             break;
         }
-        else
-        {
-            index += jump;
-        }
 
+        index += jump;
         this->_update_entity_indices.emplace_back(index);
         index += 1;
     }
@@ -941,14 +1155,48 @@ void Client::_get_update_indices(BitStream& stream)
 
 // THIS MUST BE CALLED AFTER _get_update_indices
 /// \sa https://github.com/markus-wa/demoinfocs-golang/blob/9c61151c71c3821c194f60380cac3777e18e7f6d/pkg/demoinfocs/sendtables/entity.go#L104
-void Client::_update_entity(Entity& entity, BitStream& stream)
+void Client::_update_entity(Instance<EntityType>& entity, BitStream& stream)
+{
+    entity.type->plan.decode(entity.address.get(), stream, this->_update_entity_indices);
+}
+
+const Baseline* Client::_baseline(const ServerClass& server_class)
+{
+    if (this->_baselines.size() <= server_class.index)
+    {
+        this->_baselines.resize(this->_server_classes.size());
+    }
+
+    std::optional<std::unique_ptr<Baseline>>& slot = this->_baselines.at(server_class.index);
+    if (!slot.has_value())
+    {
+        slot.emplace();
+        VERIFY(this->_string_tables.instance_baseline != nullptr);
+        for (const std::shared_ptr<StringTable::Entry>& entry : this->_string_tables.instance_baseline->entries)
+        {
+            if (entry != nullptr && std::stoi(entry->string) == server_class.index)
+            {
+                auto baseline = std::make_unique<Baseline>(server_class.data_table->type());
+                BitStream stream(entry->data);
+                this->_get_update_indices(stream);
+                this->_update_entity(*baseline, stream);
+                slot = std::move(baseline);
+                break;
+            }
+        }
+    }
+
+    return slot->get();
+}
+
+std::shared_ptr<const EntityType> Client::_construct_type(const ServerClass& server_class) const
 {
-    for (uint16_t i : this->_update_entity_indices)
+    const PrioritizedOrders* orders{nullptr};
+    if (this->_schema != nullptr && this->_schema->orders.has_value())
     {
-        // Actually update the field
-        const EntityDatum& datum = entity.type->prioritized[i];
-        datum.type->update(entity.address.get() + datum.offset, stream, datum.property.get());
+        orders = &this->_schema->orders.value();
     }
+    return server_class.data_table->construct_type(orders);
 }
 
 void Client::create_entity(Entity::Id id, BitStream& stream)
@@ -963,30 +1211,47 @@ void Client::create_entity(Entity::Id id, BitStream& stream)
 
     this->before_entity_creation(id, server_class);
 
-    VERIFY(server_class->data_table->type() != nullptr);
-    std::shared_ptr<Entity> entity = std::make_shared<Entity>(
-        server_class->data_table->type(),
+    std::shared_ptr<const EntityType> type = this->_lazy_types ? this->_construct_type(*server_class) : server_class->data_table->type();
+    VERIFY(type != nullptr);
+    std::shared_ptr<Entity> entity = this->_entity_pool->acquire(
+        std::move(type),
         id,
-        server_class
+        server_class,
+        this->_baseline(*server_class)
     );
 
-    // Update from baseline in string table
-    VERIFY(this->_string_tables.instance_baseline != nullptr);
-    for (std::shared_ptr<StringTable::Entry>& entry : this->_string_tables.instance_baseline->entries)
+    // Update from provided data
+    this->_get_update_indices(stream);
+    this->_update_entity(*entity, stream);
+    entity->dirty.fill();
+    entity->dirty_tick = this->_tick;
+    if (this->_change_log != nullptr)
     {
-        if (std::stoi(entry->string) == server_class->index)
+        this->_change_log->assign(this->_tick, *entity);
+    }
+
+    if (this->_history != nullptr)
+    {
+        this->_history->before_replace(this->_tick, id, this->_entities.get(id));
+    }
+
+    // The slot may have held an entity of another class
+    if (!this->_column_stores.empty())
+    {
+        std::shared_ptr<Entity> previous = this->_entities.get(id);
+        if (previous != nullptr)
         {
-            BitStream baseline(entry->data);
-            // TODO: this could be optimized if it's slow--it's probably not
-            this->_get_update_indices(baseline);
-            this->_update_entity(*entity, baseline);
-            break;
+            for (ColumnStore* store : this->_column_stores_of(*previous->server_class))
+            {
+                store->erase(id);
+            }
+        }
+        for (ColumnStore* store : this->_column_stores_of(*server_class))
+        {
+            store->assign(*entity);
         }
     }
 
-    // Update from provided data
-    this->_get_update_indices(stream);
-    this->_update_entity(*entity, stream);
     this->_entities.emplace(id, std::shared_ptr(entity));
     this->on_entity_creation(entity);
 }
@@ -997,9 +1262,43 @@ void Client::update_entity(Entity::Id id, BitStream& stream)
     const std::shared_ptr<Entity>& entity = this->_entities.at(id);
     // don't want a callback during entity creation so repeat this code
     this->_get_update_indices(stream);
-    this->before_entity_update(entity, this->_update_entity_indices);
+
+    if (this->_observes_entity_updates)
+    {
+        this->before_entity_update(entity, this->_update_entity_indices);
+    }
+
+    if (this->_history != nullptr)
+    {
+        this->_history->before_update(this->_tick, *entity);
+    }
+
     this->_update_entity(*entity, stream);
-    this->on_entity_update(entity, this->_update_entity_indices);
+
+    // Decoding checked the indices; accumulate changes within a tick, starting over on the next
+    if (entity->dirty_tick != this->_tick)
+    {
+        entity->dirty.reset();
+        entity->dirty_tick = this->_tick;
+    }
+    for (uint16_t index : this->_update_entity_indices)
+    {
+        entity->dirty.set(index);
+    }
+
+    for (ColumnStore* store : this->_column_stores_of(*entity->server_class))
+    {
+        store->update(*entity, this->_update_entity_indices);
+    }
+    if (this->_change_log != nullptr)
+    {
+        this->_change_log->update(this->_tick, *entity, this->_update_entity_indices);
+    }
+
+    if (this->_observes_entity_updates)
+    {
+        this->on_entity_update(entity, this->_update_entity_indices);
+    }
 }
 
 void Client::delete_entity(Entity::Id id)
@@ -1009,6 +1308,14 @@ void Client::delete_entity(Entity::Id id)
     VERIFY(entity != nullptr);
 
     this->before_entity_deletion(entity);
+    for (ColumnStore* store : this->_column_stores_of(*entity->server_class))
+    {
+        store->erase(id);
+    }
+    if (this->_history != nullptr)
+    {
+        this->_history->before_replace(this->_tick, id, entity);
+    }
     this->_entities.at(id) = nullptr;
     this->on_entity_deletion(std::move(entity));
 }
@@ -1130,4 +1437,253 @@ void Client::advance_packet_unknown(CodedInputStream& stream, uint32_t command)
     throw GameError("unrecognized message " + std::string(demo::describe_net_message(command)));
 }
 
+static uint8_t describe_game_event_value_type(const std::shared_ptr<const object::Type>& type)
+{
+    for (uint8_t code = 1; code <= 8; ++code)
+    {
+        if (game_event::lookup_type(code) == type)
+        {
+            return code;
+        }
+    }
+    throw CheckpointError("cannot checkpoint game event value type " + type->represent());
+}
+
+Checkpoint Client::checkpoint(uint64_t offset) const
+{
+    Checkpoint checkpoint;
+    checkpoint.tick = this->_tick;
+    checkpoint.cursor = this->_cursor;
+    checkpoint.offset = offset;
+
+    Writer writer;
+    writer.write<uint64_t>(this->_schema_hash);
+    writer.write<uint8_t>(this->_inline_strings);
+
+    writer.write<uint32_t>(this->_string_tables.size());
+    for (const std::shared_ptr<StringTable>& string_table : this->_string_tables)
+    {
+        writer.write<uint8_t>(string_table != nullptr);
+        if (string_table != nullptr)
+        {
+            writer.write(string_table->name);
+            writer.write<uint64_t>(string_table->capacity);
+            writer.write<uint8_t>(string_table->data_fixed);
+            writer.write<uint64_t>(string_table->data_size_bits);
+            writer.write<uint32_t>(string_table->entries.size());
+            for (const std::shared_ptr<StringTable::Entry>& entry : string_table->entries)
+            {
+                writer.write<uint8_t>(entry != nullptr);
+                if (entry != nullptr)
+                {
+                    writer.write(entry->string);
+                    writer.write(entry->data);
+                }
+            }
+        }
+    }
+
+    writer.write<uint32_t>(this->_game_event_types.size());
+    for (const std::shared_ptr<GameEventType>& game_event_type : this->_game_event_types)
+    {
+        writer.write<uint8_t>(game_event_type != nullptr);
+        if (game_event_type != nullptr)
+        {
+            writer.write<GameEventType::Id>(game_event_type->id);
+            writer.write(game_event_type->name);
+            writer.write<uint32_t>(game_event_type->members.size());
+            for (const GameEventType::Member& member : game_event_type->members)
+            {
+                writer.write(member.name);
+                writer.write<uint8_t>(describe_game_event_value_type(member.type));
+            }
+        }
+    }
+
+    writer.write<uint32_t>(this->_users.size());
+    for (const std::shared_ptr<User>& user : this->_users)
+    {
+        writer.write<uint8_t>(user != nullptr);
+        if (user != nullptr)
+        {
+            writer.write<User::Index>(user->index);
+            writer.write<uint64_t>(user->version);
+            writer.write<uint64_t>(user->xuid);
+            writer.write(user->name);
+            writer.write<User::Id>(user->id);
+            writer.write(user->guid);
+            writer.write<uint32_t>(user->friends_id);
+            writer.write(user->friends_name);
+            writer.write<uint8_t>(user->is_fake);
+            writer.write<uint8_t>(user->is_hltv);
+            writer.write(user->custom_files);
+            writer.write<uint8_t>(user->files_downloaded);
+        }
+    }
+
+    writer.write<uint32_t>(this->_entities.size());
+    for (const std::shared_ptr<Entity>& entity : this->_entities)
+    {
+        writer.write<uint8_t>(entity != nullptr);
+        if (entity != nullptr)
+        {
+            writer.write<Entity::Id>(entity->id);
+            writer.write<ServerClass::Index>(entity->server_class->index);
+            writer.write(*entity->type, entity->address.get());
+        }
+    }
+
+    checkpoint.state = std::move(writer.data);
+    return checkpoint;
+}
+
+void Client::restore(const Checkpoint& checkpoint)
+{
+    Reader reader(checkpoint.state);
+    if (reader.read<uint64_t>() != this->_schema_hash)
+    {
+        throw CheckpointError("checkpoint was taken against a different schema");
+    }
+    if (reader.read<uint8_t>() != this->_inline_strings)
+    {
+        // Entities are laid out differently with inline strings
+        throw CheckpointError("checkpoint was taken with different inline strings");
+    }
+
+    StringTableDatabase string_tables;
+    auto string_table_count = reader.read<uint32_t>();
+    for (uint32_t i = 0; i < string_table_count; ++i)
+    {
+        if (!reader.read<uint8_t>())
+        {
+            continue;
+        }
+
+        std::string name = reader.read_string();
+        auto string_table = std::make_shared<StringTable>(std::move(name), 0);
+        string_table->capacity = reader.read<uint64_t>();
+        string_table->data_fixed = reader.read<uint8_t>();
+        string_table->data_size_bits = reader.read<uint64_t>();
+
+        auto entry_count = reader.read<uint32_t>();
+        string_table->entries.container.resize(entry_count);
+        for (uint32_t j = 0; j < entry_count; ++j)
+        {
+            if (reader.read<uint8_t>())
+            {
+                auto entry = std::make_shared<StringTable::Entry>();
+                entry->string = reader.read_string();
+                entry->data = reader.read_string();
+                string_table->entries.emplace(j, std::move(entry));
+            }
+        }
+
+        string_tables.emplace(i, std::move(string_table));
+    }
+
+    GameEventTypeDatabase game_event_types;
+    auto game_event_type_count = reader.read<uint32_t>();
+    for (uint32_t i = 0; i < game_event_type_count; ++i)
+    {
+        if (!reader.read<uint8_t>())
+        {
+            continue;
+        }
+
+        csgo::message::net::CSVCMsg_GameEventList_descriptor_t descriptor;
+        descriptor.set_eventid(reader.read<GameEventType::Id>());
+        descriptor.set_name(reader.read_string());
+        auto member_count = reader.read<uint32_t>();
+        for (uint32_t j = 0; j < member_count; ++j)
+        {
+            csgo::message::net::CSVCMsg_GameEventList_key_t& key = *descriptor.add_keys();
+            key.set_name(reader.read_string());
+            key.set_type(reader.read<uint8_t>());
+        }
+
+        game_event_types.emplace(GameEventType::build(std::move(descriptor)));
+    }
+
+    UserDatabase users;
+    auto user_count = reader.read<uint32_t>();
+    for (uint32_t i = 0; i < user_count; ++i)
+    {
+        if (!reader.read<uint8_t>())
+        {
+            continue;
+        }
+
+        auto user = std::make_shared<User>(reader.read<User::Index>());
+        user->version = reader.read<uint64_t>();
+        user->xuid = reader.read<uint64_t>();
+        user->name = reader.read_string();
+        user->id = reader.read<User::Id>();
+        user->guid = reader.read_string();
+        user->friends_id = reader.read<uint32_t>();
+        user->friends_name = reader.read_string();
+        user->is_fake = reader.read<uint8_t>();
+        user->is_hltv = reader.read<uint8_t>();
+        for (uint32_t& custom_file : user->custom_files)
+        {
+            custom_file = reader.read<uint32_t>();
+        }
+        user->files_downloaded = reader.read<uint8_t>();
+        users.emplace(i, std::move(user));
+    }
+
+    EntityDatabase entities;
+    auto entity_count = reader.read<uint32_t>();
+    entities.container.resize(entity_count);
+    for (uint32_t i = 0; i < entity_count; ++i)
+    {
+        if (!reader.read<uint8_t>())
+        {
+            continue;
+        }
+
+        auto id = reader.read<Entity::Id>();
+        const std::shared_ptr<ServerClass>& server_class = this->_server_classes.at(reader.read<ServerClass::Index>());
+        std::shared_ptr<const EntityType> type = this->_construct_type(*server_class);
+        VERIFY(type != nullptr);
+        auto entity = this->_entity_pool->acquire(std::move(type), id, server_class, nullptr);
+        reader.read(*entity->type, entity->address.get());
+        entities.emplace(i, std::move(entity));
+    }
+
+    if (reader.position != checkpoint.state.size())
+    {
+        throw CheckpointError("checkpoint has trailing state");
+    }
+
+    this->_tick = checkpoint.tick;
+    this->_cursor = checkpoint.cursor;
+    this->_string_tables = std::move(string_tables);
+    this->_baselines.clear();
+    if (this->_history != nullptr)
+    {
+        this->_history->clear(this->_tick);
+    }
+    this->_game_event_types = std::move(game_event_types);
+    this->_users = std::move(users);
+    if (!this->_events_only)
+    {
+        this->_entities = std::move(entities);
+        for (const std::shared_ptr<ColumnStore>& store : this->_column_stores)
+        {
+            store->clear();
+        }
+        for (const std::shared_ptr<Entity>& entity : this->_entities)
+        {
+            if (entity == nullptr)
+            {
+                continue;
+            }
+            for (ColumnStore* store : this->_column_stores_of(*entity->server_class))
+            {
+                store->assign(*entity);
+            }
+        }
+    }
+}
+
 }
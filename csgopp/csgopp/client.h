@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+#include <span>
 #include <string>
 #include <absl/container/flat_hash_map.h>
 #include <absl/container/flat_hash_set.h>
@@ -12,13 +14,22 @@
 #include "common/ring.h"
 #include "common/database.h"
 #include "common/control.h"
+#include "common/hash.h"
 #include "demo.h"
 #include "client/data_table.h"
 #include "client/server_class.h"
 #include "client/string_table.h"
 #include "client/entity.h"
+#include "client/entity_pool.h"
+#include "client/history.h"
 #include "client/game_event.h"
 #include "client/user.h"
+#include "client/change_log.h"
+#include "client/checkpoint.h"
+#include "client/column_store.h"
+#include "client/packet_filter.h"
+#include "client/schema_cache.h"
+#include "client/pipeline.h"
 #include "netmessages.pb.h"
 
 #define LOCAL(EVENT) _event_##EVENT
@@ -52,13 +63,25 @@
 namespace csgopp::client
 {
 
+using csgopp::client::change_log::ChangeLog;
+using csgopp::client::checkpoint::Checkpoint;
+using csgopp::client::checkpoint::Checkpoints;
+using csgopp::client::column_store::ColumnStore;
 using csgopp::client::data_table::DataTable;
 using csgopp::client::data_table::is_array_index;
+using csgopp::client::entity::Baseline;
 using csgopp::client::entity::Entity;
 using csgopp::client::entity::EntityDatum;
 using csgopp::client::entity::EntityType;
+using csgopp::client::entity_pool::EntityPool;
+using csgopp::client::history::History;
+using csgopp::client::pipeline::Frame;
+using csgopp::client::pipeline::Message;
 using csgopp::client::game_event::GameEvent;
 using csgopp::client::game_event::GameEventType;
+using csgopp::client::packet_filter::PacketFilter;
+using csgopp::client::schema_cache::Schema;
+using csgopp::client::schema_cache::SchemaCache;
 using csgopp::client::server_class::ServerClass;
 using csgopp::client::string_table::StringTable;
 using csgopp::client::user::User;
@@ -73,6 +96,7 @@ using csgopp::common::ring::Ring;
 using csgopp::demo::Header;
 using csgopp::error::GameError;
 using google::protobuf::io::CodedInputStream;
+using object::Instance;
 
 /// \brief The core DEMO parser and game client.
 ///
@@ -101,6 +125,17 @@ public:
 
     /// How about now? Is the issue any better?
     virtual bool advance(CodedInputStream& stream);
+
+    /// \brief Apply a frame read ahead by a `pipeline::Pipeline`.
+    ///
+    /// Hooks and ticks are exactly as if the frame had been read from a
+    /// stream. Parsed `svc_PacketEntities` go straight to the overload of
+    /// `advance_packet_packet_entities` taking the message, and every other
+    /// message through the usual `advance_packet`.
+    virtual bool advance(Frame& frame);
+
+    /// \brief Dispatch the payload of a frame after its command and tick.
+    virtual bool advance_command(CodedInputStream& stream, char command);
     virtual void advance_packets(CodedInputStream& stream);
     virtual void advance_packet(CodedInputStream& stream);
     virtual void advance_packet_nop(CodedInputStream& stream);
@@ -130,6 +165,7 @@ public:
     virtual void advance_packet_entity_message(CodedInputStream& stream);
     virtual void advance_packet_game_event(CodedInputStream& stream);
     virtual void advance_packet_packet_entities(CodedInputStream& stream);
+    virtual void advance_packet_packet_entities(const csgo::message::net::CSVCMsg_PacketEntities& data);
     virtual void advance_packet_temporary_entities(CodedInputStream& stream);
     virtual void advance_packet_prefetch(CodedInputStream& stream);
     virtual void advance_packet_menu(CodedInputStream& stream);
@@ -184,10 +220,157 @@ public:
     [[nodiscard]] const DataTableDatabase& data_tables() const { return this->_data_tables; }
     [[nodiscard]] const ServerClassDatabase& server_classes() const { return this->_server_classes; }
     [[nodiscard]] const StringTableDatabase& string_tables() const { return this->_string_tables; }
-    [[nodiscard]] const EntityDatabase& entities() const { return this->_entities; }
+    /// \throws GameError in events-only mode, where entities are not decoded.
+    [[nodiscard]] const EntityDatabase& entities() const;
     [[nodiscard]] const GameEventTypeDatabase& game_event_types() const { return this->_game_event_types; }
     [[nodiscard]] const UserDatabase& users() const { return this->_users; }
 
+    /// \brief The free lists entities are recycled through.
+    [[nodiscard]] EntityPool& entity_pool() { return *this->_entity_pool; }
+    [[nodiscard]] const EntityPool& entity_pool() const { return *this->_entity_pool; }
+
+    /// \brief Keep selected properties of a server class in columns.
+    ///
+    /// The store is bound as soon as the server class exists, so this may
+    /// be called before or after the schema is parsed. Live entities of
+    /// the class are copied in when it is bound, then as they are created
+    /// and updated; only changed properties are copied on update.
+    ///
+    /// \param server_class the name of the server class, e.g. `CCSPlayer`.
+    /// \param properties qualified property names, see `EntityDatum::qualified_name`.
+    /// \throws ColumnStoreError once bound if a property is missing or holds strings.
+    std::shared_ptr<const ColumnStore> track_columns(std::string server_class, std::vector<std::string> properties);
+
+    /// \brief Keep the state of every entity over the last few ticks.
+    ///
+    /// Only entities that change in a tick cost memory for it, see
+    /// `csgopp::client::history`. States are known from the current tick
+    /// onwards; zero ticks disables the history.
+    ///
+    /// \param ticks how many ticks back `entity_at` can look.
+    /// \param budget the bytes of entity state to keep at most, which may
+    ///     cut the history short.
+    void set_history(uint32_t ticks, size_t budget = History::DEFAULT_BUDGET);
+    [[nodiscard]] const History* history() const { return this->_history.get(); }
+
+    /// \brief Get the entity in a slot as of the end of an earlier tick.
+    ///
+    /// \return the entity, or null if the slot was empty. States from the
+    ///     history must not be modified.
+    /// \throws HistoryError if there is no history or it doesn't reach back
+    ///     to the tick.
+    [[nodiscard]] std::shared_ptr<const Entity> entity_at(Entity::Id id, uint32_t tick) const;
+
+    /// \brief Log every property change from now on, see `csgopp::client::change_log`.
+    ///
+    /// Entities are logged in full when created and by changed property
+    /// when updated. Null stops logging.
+    void set_change_log(std::shared_ptr<ChangeLog> change_log) { this->_change_log = std::move(change_log); }
+    [[nodiscard]] const std::shared_ptr<ChangeLog>& change_log() const { return this->_change_log; }
+
+    /// \brief Serialize the client's accumulated state.
+    ///
+    /// \param offset the byte offset of the next frame in the demo.
+    /// \return a checkpoint that can later be passed to `restore`.
+    [[nodiscard]] Checkpoint checkpoint(uint64_t offset) const;
+
+    /// \brief Replace the client's state with a checkpoint.
+    ///
+    /// The client must already have built the schema the checkpoint was
+    /// taken against, which is checked by the hash of the send tables it
+    /// has read, and with the same `inline_strings`. No observer hooks are
+    /// emitted for restored objects. The caller must reposition its stream
+    /// at `checkpoint.offset`.
+    ///
+    /// \throws CheckpointError if the schema or string layout differs.
+    void restore(const Checkpoint& checkpoint);
+
+    /// \brief Record a checkpoint automatically every so many ticks.
+    ///
+    /// Checkpoints are taken at frame boundaries once the schema exists;
+    /// zero (the default) disables checkpointing.
+    void set_checkpoint_interval(uint32_t ticks) { this->_checkpoint_interval = ticks; }
+    [[nodiscard]] uint32_t checkpoint_interval() const { return this->_checkpoint_interval; }
+    [[nodiscard]] Checkpoints& checkpoints() { return this->_checkpoints; }
+    [[nodiscard]] const Checkpoints& checkpoints() const { return this->_checkpoints; }
+
+    /// \brief Restrict which net messages are parsed and passed to hooks.
+    ///
+    /// Messages outside the filter are skipped by their length without a
+    /// virtual call or `before_packet`/`on_packet`. `PacketFilter::required()`
+    /// is always merged in so the client's own state stays consistent, less
+    /// `svc_PacketEntities` in events-only mode.
+    void set_packet_filter(const PacketFilter& filter);
+    [[nodiscard]] const PacketFilter& packet_filter() const { return this->_packet_filter; }
+
+    /// \brief Parse only game events, users and string tables.
+    ///
+    /// In events-only mode `svc_PacketEntities` is skipped by its length,
+    /// so no entity is ever created, updated or deleted and none of the
+    /// entity hooks fire. Entity types aren't constructed either, as with
+    /// `set_lazy_types`, so `ServerClass::type()` stays null. Calling
+    /// `entities()` throws a `GameError`. This is intended for jobs like
+    /// kill-feed or round result extraction that never look at entity
+    /// state, and should be set before advancing.
+    void set_events_only(bool events_only);
+    [[nodiscard]] bool events_only() const { return this->_events_only; }
+
+    /// \brief Whether entity updates are passed to the update hooks.
+    ///
+    /// When disabled, `before_entity_update` and `on_entity_update` are not
+    /// called, which saves two virtual calls and two `shared_ptr` copies per
+    /// update. It is enabled by default; callers that know nothing observes
+    /// updates should turn it off themselves.
+    void set_observes_entity_updates(bool observes) { this->_observes_entity_updates = observes; }
+    [[nodiscard]] bool observes_entity_updates() const { return this->_observes_entity_updates; }
+
+    /// \brief Store string properties inline rather than as `std::string`.
+    ///
+    /// String properties become `InlineString`s, fixed buffers of
+    /// `STRING_SIZE_MAX` bytes, so entity types are trivially copyable and
+    /// string updates never allocate. Entities grow by about half a kilobyte
+    /// per string property. Since this determines the layout of every entity
+    /// type, it must be set before data tables are parsed and throws an
+    /// `Error` otherwise.
+    void set_inline_strings(bool inline_strings);
+    [[nodiscard]] bool inline_strings() const { return this->_inline_strings; }
+
+    /// \brief Construct entity types on this many threads, zero for all cores.
+    ///
+    /// Types are built on a pool in dependency order once data tables are
+    /// parsed, see `server_class::construct_types`. One thread, the default,
+    /// builds them in sequence on the calling thread. Hooks are called in
+    /// the same order either way.
+    void set_construction_threads(size_t threads) { this->_construction_threads = threads; }
+    [[nodiscard]] size_t construction_threads() const { return this->_construction_threads; }
+
+    /// \brief Construct entity types only once an entity needs them.
+    ///
+    /// Most server classes never see an instance, so by default building
+    /// every type up front wastes time and memory on short parses. Lazily,
+    /// a server class's type is constructed the first time `create_entity`
+    /// sees it, or when a column store or checkpoint needs it, and
+    /// `ServerClass::type()` is null until then. Hooks such as
+    /// `on_server_class_creation` that need the type should call
+    /// `server_class->data_table->construct_type()` instead. Construction
+    /// is guarded per data table, so schemas shared through a `SchemaCache`
+    /// stay safe to use from several clients.
+    void set_lazy_types(bool lazy) { this->_lazy_types = lazy; }
+    [[nodiscard]] bool lazy_types() const { return this->_lazy_types; }
+
+    /// \brief Reuse schemas built from identical send tables.
+    ///
+    /// The schema in the demo's `DATA_TABLES` frame is looked up in the
+    /// cache and only built if it's missing, see `csgopp::client::schema_cache`.
+    /// Clients on other threads may share the cache, e.g. `SchemaCache::shared()`.
+    /// Cached data tables, server classes and entity types are shared by
+    /// every client using them, so observers must not modify them.
+    void set_schema_cache(std::shared_ptr<SchemaCache> cache) { this->_schema_cache = std::move(cache); }
+    [[nodiscard]] const std::shared_ptr<SchemaCache>& schema_cache() const { return this->_schema_cache; }
+
+    /// \brief The cached schema in use, if any.
+    [[nodiscard]] const std::shared_ptr<const Schema>& schema() const { return this->_schema; }
+
 protected:
     Header _header;
     uint32_t _cursor{0};
@@ -198,19 +381,55 @@ protected:
     EntityDatabase _entities;
     GameEventTypeDatabase _game_event_types;
     UserDatabase _users;
+    uint32_t _checkpoint_interval{0};
+    Checkpoints _checkpoints;
+    /// FNV-1a of every send table read, chained in order
+    uint64_t _schema_hash{csgopp::common::hash::FNV_OFFSET};
+    PacketFilter _packet_filter{PacketFilter::all()};
+    bool _events_only{false};
+    bool _observes_entity_updates{true};
+    bool _inline_strings{false};
+    size_t _construction_threads{1};
+    bool _lazy_types{false};
 
     /// Helper data
     std::vector<uint16_t> _update_entity_indices;
 
+    /// Decoded instance baselines by server class index. Slots that have
+    /// not been looked up are empty; null means the class has no baseline.
+    std::vector<std::optional<std::unique_ptr<Baseline>>> _baselines;
+
+    /// Shared so that entities outliving the client can still release
+    std::shared_ptr<EntityPool> _entity_pool{std::make_shared<EntityPool>()};
+
+    std::shared_ptr<SchemaCache> _schema_cache;
+    std::shared_ptr<const Schema> _schema;
+    std::unique_ptr<History> _history;
+    std::shared_ptr<ChangeLog> _change_log;
+
+    std::vector<std::shared_ptr<ColumnStore>> _column_stores;
+    /// Bound stores by server class index
+    std::vector<std::vector<ColumnStore*>> _column_stores_by_class;
+
     /// Helpers
-    void create_data_tables_and_server_classes(CodedInputStream& stream);
+    void create_data_tables_and_server_classes(const std::string& data);
+    void create_schema(const std::string& data);
+    void emplace_schema(const DataTableDatabase& new_data_tables, const Database<ServerClass>& new_server_classes);
     DatabaseWithName<DataTable> create_data_tables(CodedInputStream& stream);
     Database<ServerClass> create_server_classes(CodedInputStream& stream, DatabaseWithName<DataTable>& new_data_tables);
 
     void populate_string_table(StringTable& string_table, const std::string& blob, int32_t count);
 
+    void _finish_frame(char command, bool ok, int64_t position);
+    void _advance_message(Message& message);
+
     void _get_update_indices(BitStream& stream);
-    void _update_entity(Entity& entity, BitStream& stream);
+    void _update_entity(Instance<EntityType>& entity, BitStream& stream);
+    const Baseline* _baseline(const ServerClass& server_class);
+    std::shared_ptr<const EntityType> _construct_type(const ServerClass& server_class) const;
+    void _bind_column_stores();
+    void _bind_column_store(const std::shared_ptr<ColumnStore>& store);
+    std::span<ColumnStore* const> _column_stores_of(const ServerClass& server_class) const;
     void create_entity(Entity::Id id, BitStream& stream);
     void update_entity(Entity::Id id, BitStream& stream);
     void delete_entity(Entity::Id id);
@@ -0,0 +1,555 @@
+#include "change_log.h"
+#include "server_class.h"
+#include "../common/vector.h"
+
+#include <fstream>
+#include <iterator>
+
+namespace csgopp::client::change_log
+{
+
+using csgopp::client::checkpoint::Reader;
+using csgopp::client::entity::EntityDatum;
+using csgopp::common::vector::Vector2;
+using csgopp::common::vector::Vector3;
+using object::ArrayType;
+using object::ObjectType;
+using object::ValueType;
+
+// Dictionary codes, after which come dictionary indices
+constexpr uint32_t CODE_LITERAL = 0;
+constexpr uint32_t CODE_LITERAL_UNSAVED = 1;
+constexpr uint32_t CODE_FIRST = 2;
+
+static void write_varint(std::string& data, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        data.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<char>(value));
+}
+
+static uint64_t zigzag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static int64_t unzigzag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/// Whether `Writer` copies values of the type verbatim.
+static bool is_raw(const Type& type)
+{
+    if (const auto* object_type = dynamic_cast<const ObjectType*>(&type))
+    {
+        for (const ObjectType::Member& member : *object_type)
+        {
+            if (!is_raw(*member.type))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    else if (const auto* array_type = dynamic_cast<const ArrayType*>(&type))
+    {
+        return is_raw(*array_type->element_type);
+    }
+    else if (const auto* value_type = dynamic_cast<const ValueType*>(&type))
+    {
+        return value_type->info() != typeid(std::string) && value_type->info() != typeid(std::wstring);
+    }
+    return false;
+}
+
+/// Whether values of the type are a run of floats, like vectors.
+static bool is_floats(const Type& type)
+{
+    if (const auto* array_type = dynamic_cast<const ArrayType*>(&type))
+    {
+        return is_floats(*array_type->element_type);
+    }
+    else if (const auto* value_type = dynamic_cast<const ValueType*>(&type))
+    {
+        const std::type_info& info = value_type->info();
+        return info == typeid(float) || info == typeid(Vector2) || info == typeid(Vector3);
+    }
+    return false;
+}
+
+/// The integer type of values of the type or of their elements, if any.
+static const ValueType* integer_type(const Type& type)
+{
+    if (const auto* array_type = dynamic_cast<const ArrayType*>(&type))
+    {
+        return integer_type(*array_type->element_type);
+    }
+    else if (const auto* value_type = dynamic_cast<const ValueType*>(&type))
+    {
+        const std::type_info& info = value_type->info();
+        if (info == typeid(bool) || info == typeid(uint32_t) || info == typeid(uint64_t)
+            || info == typeid(int32_t) || info == typeid(int64_t))
+        {
+            return value_type;
+        }
+    }
+    return nullptr;
+}
+
+/// The last words or integers of an entity's value, grown to fit the entity.
+template<typename T>
+static T* entity_previous(std::vector<T>& previous, Entity::Id id, size_t count)
+{
+    if ((id + 1) * count > previous.size())
+    {
+        previous.resize((id + 1) * count, 0);
+    }
+    return previous.data() + id * count;
+}
+
+static int64_t load_integer(const Track& track, const char* address)
+{
+    switch (track.element_size)
+    {
+        case 1:
+            return *reinterpret_cast<const uint8_t*>(address);
+        case 4:
+            return track.is_signed
+                ? *reinterpret_cast<const int32_t*>(address)
+                : *reinterpret_cast<const uint32_t*>(address);
+        default:
+            return *reinterpret_cast<const int64_t*>(address);
+    }
+}
+
+uint64_t Track::Reader::read_varint()
+{
+    uint64_t value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        if (this->_position >= this->_track.records.size())
+        {
+            throw ChangeLogError("truncated record in track " + this->_track.name);
+        }
+
+        auto byte = static_cast<uint8_t>(this->_track.records[this->_position++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+
+    throw ChangeLogError("malformed varint in track " + this->_track.name);
+}
+
+bool Track::Reader::next(Record& record)
+{
+    if (this->_position >= this->_track.records.size())
+    {
+        return false;
+    }
+
+    this->_tick += static_cast<uint32_t>(unzigzag(this->read_varint()));
+    record.tick = this->_tick;
+    record.id = static_cast<Entity::Id>(this->read_varint());
+
+    if (this->_track.encoding == Encoding::DELTA)
+    {
+        size_t count = this->_track.size / this->_track.element_size;
+        int64_t* previous = entity_previous(this->_previous, record.id, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            previous[i] = static_cast<int64_t>(static_cast<uint64_t>(previous[i]) + static_cast<uint64_t>(unzigzag(this->read_varint())));
+        }
+
+        if (count == 1)
+        {
+            record.integer = previous[0];
+            record.literal = {};
+            return true;
+        }
+
+        // Lay arrays out as they are in the entity, truncating each element
+        this->_elements.resize(this->_track.size);
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::memcpy(this->_elements.data() + i * this->_track.element_size, &previous[i], this->_track.element_size);
+        }
+        record.integer = 0;
+        record.literal = this->_elements;
+        return true;
+    }
+
+    if (this->_track.encoding == Encoding::XOR)
+    {
+        size_t words = this->_track.size / sizeof(uint32_t);
+        uint32_t* previous = entity_previous(this->_previous_bits, record.id, words);
+        for (size_t i = 0; i < words; ++i)
+        {
+            previous[i] ^= static_cast<uint32_t>(this->read_varint());
+        }
+        record.integer = 0;
+        record.literal = std::string_view(reinterpret_cast<const char*>(previous), this->_track.size);
+        return true;
+    }
+
+    uint64_t code = this->read_varint();
+    if (code >= CODE_FIRST)
+    {
+        if (code - CODE_FIRST >= this->_dictionary.size())
+        {
+            throw ChangeLogError("unknown dictionary code in track " + this->_track.name);
+        }
+        record.literal = this->_dictionary[code - CODE_FIRST];
+        return true;
+    }
+
+    uint64_t size = this->read_varint();
+    if (size > this->_track.records.size() - this->_position)
+    {
+        throw ChangeLogError("truncated literal in track " + this->_track.name);
+    }
+
+    record.literal = std::string_view(this->_track.records).substr(this->_position, size);
+    this->_position += size;
+    if (code == CODE_LITERAL)
+    {
+        this->_dictionary.push_back(record.literal);
+    }
+    return true;
+}
+
+ChangeLog::ChangeLog(size_t dictionary_size)
+    : _dictionary_size(dictionary_size)
+{
+}
+
+void ChangeLog::assign(uint32_t tick, const Entity& entity)
+{
+    Table& table = this->table(entity);
+    for (size_t i = 0; i < entity.type->prioritized.size(); ++i)
+    {
+        this->append(this->track(table, static_cast<uint16_t>(i)), tick, entity, static_cast<uint16_t>(i));
+    }
+}
+
+void ChangeLog::update(uint32_t tick, const Entity& entity, const std::vector<uint16_t>& indices)
+{
+    Table& table = this->table(entity);
+    for (uint16_t index : indices)
+    {
+        this->append(this->track(table, index), tick, entity, index);
+    }
+}
+
+ChangeLog::Table& ChangeLog::table(const Entity& entity)
+{
+    size_t index = entity.server_class->index;
+    if (index >= this->_tables_by_class.size())
+    {
+        this->_tables_by_class.resize(index + 1, nullptr);
+    }
+
+    Table*& slot = this->_tables_by_class[index];
+    if (slot != nullptr && slot->type == entity.type)
+    {
+        return *slot;
+    }
+
+    // New class, or a new schema, so look the table up by name
+    slot = nullptr;
+    for (const std::unique_ptr<Table>& table : this->_tables)
+    {
+        if (table->server_class == entity.server_class->name)
+        {
+            slot = table.get();
+            break;
+        }
+    }
+    if (slot == nullptr)
+    {
+        slot = this->_tables.emplace_back(std::make_unique<Table>()).get();
+        slot->server_class = entity.server_class->name;
+    }
+
+    slot->type = entity.type;
+    slot->by_index.assign(entity.type->prioritized.size(), nullptr);
+    return *slot;
+}
+
+Track& ChangeLog::track(Table& table, uint16_t index)
+{
+    if (index >= table.by_index.size())
+    {
+        throw ChangeLogError("property index " + std::to_string(index) + " out of range for " + table.server_class);
+    }
+
+    Track*& slot = table.by_index[index];
+    if (slot != nullptr)
+    {
+        return *slot;
+    }
+
+    const EntityDatum& datum = table.type->prioritized[index];
+    std::string name = datum.qualified_name();
+    for (const std::unique_ptr<Track>& track : table.tracks)
+    {
+        if (track->name == name)
+        {
+            if (track->type == nullptr)
+            {
+                throw ChangeLogError("cannot append to loaded track " + name);
+            }
+            slot = track.get();
+            return *slot;
+        }
+    }
+
+    slot = table.tracks.emplace_back(std::make_unique<Track>()).get();
+    slot->name = std::move(name);
+    slot->type = datum.type;
+
+    const auto* value_type = dynamic_cast<const ValueType*>(datum.type.get());
+    const std::type_info* info = value_type != nullptr ? &value_type->info() : nullptr;
+    if (const ValueType* element_type = integer_type(*datum.type))
+    {
+        slot->encoding = Track::Encoding::DELTA;
+        slot->size = static_cast<uint32_t>(datum.type->size());
+        slot->element_size = static_cast<uint32_t>(element_type->size());
+        slot->is_signed = element_type->info() == typeid(int32_t) || element_type->info() == typeid(int64_t);
+    }
+    else if (is_floats(*datum.type))
+    {
+        slot->encoding = Track::Encoding::XOR;
+        slot->size = static_cast<uint32_t>(datum.type->size());
+    }
+    else
+    {
+        slot->encoding = Track::Encoding::DICTIONARY;
+        slot->string = info != nullptr && *info == typeid(std::string);
+
+        // Typed reads can't make sense of other literals containing strings
+        slot->size = is_raw(*datum.type) ? static_cast<uint32_t>(datum.type->size()) : 0;
+    }
+
+    return *slot;
+}
+
+void ChangeLog::append(Track& track, uint32_t tick, const Entity& entity, uint16_t index)
+{
+    const char* address = entity.address.get() + entity.type->prioritized[index].offset;
+
+    write_varint(track.records, zigzag(static_cast<int64_t>(tick) - static_cast<int64_t>(track.tick)));
+    write_varint(track.records, entity.id);
+    track.tick = tick;
+    track.count += 1;
+
+    if (track.encoding == Track::Encoding::DELTA)
+    {
+        size_t count = track.size / track.element_size;
+        int64_t* previous = entity_previous(track.previous, entity.id, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            int64_t value = load_integer(track, address + i * track.element_size);
+            write_varint(track.records, zigzag(static_cast<int64_t>(static_cast<uint64_t>(value) - static_cast<uint64_t>(previous[i]))));
+            previous[i] = value;
+        }
+        return;
+    }
+
+    // Reusing the scratch buffer means lookups that hit don't allocate
+    this->_scratch.data.clear();
+    this->_scratch.write(*track.type, address);
+
+    if (track.encoding == Track::Encoding::XOR)
+    {
+        size_t words = track.size / sizeof(uint32_t);
+        uint32_t* previous = entity_previous(track.previous_bits, entity.id, words);
+        for (size_t i = 0; i < words; ++i)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, this->_scratch.data.data() + i * sizeof(uint32_t), sizeof(uint32_t));
+            write_varint(track.records, bits ^ previous[i]);
+            previous[i] = bits;
+        }
+        return;
+    }
+
+    auto iterator = track.codes.find(this->_scratch.data);
+    if (iterator != track.codes.end())
+    {
+        write_varint(track.records, CODE_FIRST + iterator->second);
+        return;
+    }
+
+    if (track.codes.size() < this->_dictionary_size)
+    {
+        track.codes.emplace(this->_scratch.data, static_cast<uint32_t>(track.codes.size()));
+        write_varint(track.records, CODE_LITERAL);
+    }
+    else
+    {
+        write_varint(track.records, CODE_LITERAL_UNSAVED);
+    }
+
+    write_varint(track.records, this->_scratch.data.size());
+    track.records.append(this->_scratch.data);
+}
+
+const Track* ChangeLog::find(std::string_view server_class, std::string_view property) const
+{
+    for (const std::unique_ptr<Table>& table : this->_tables)
+    {
+        if (table->server_class != server_class)
+        {
+            continue;
+        }
+
+        for (const std::unique_ptr<Track>& track : table->tracks)
+        {
+            if (track->name == property)
+            {
+                return track.get();
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+uint64_t ChangeLog::size() const
+{
+    uint64_t size = 0;
+    for (const std::unique_ptr<Table>& table : this->_tables)
+    {
+        for (const std::unique_ptr<Track>& track : table->tracks)
+        {
+            size += track->count;
+        }
+    }
+    return size;
+}
+
+size_t ChangeLog::bytes() const
+{
+    size_t bytes = 0;
+    for (const std::unique_ptr<Table>& table : this->_tables)
+    {
+        for (const std::unique_ptr<Track>& track : table->tracks)
+        {
+            bytes += track->records.size();
+        }
+    }
+    return bytes;
+}
+
+void ChangeLog::clear()
+{
+    this->_tables.clear();
+    this->_tables_by_class.clear();
+}
+
+void ChangeLog::save(const std::filesystem::path& path) const
+{
+    Writer writer;
+    writer.data.append(MAGIC, sizeof(MAGIC));
+    writer.write<uint32_t>(VERSION);
+    writer.write<uint64_t>(this->_tables.size());
+    for (const std::unique_ptr<Table>& table : this->_tables)
+    {
+        writer.write(table->server_class);
+        writer.write<uint64_t>(table->tracks.size());
+        for (const std::unique_ptr<Track>& track : table->tracks)
+        {
+            writer.write(track->name);
+            writer.write<uint8_t>(static_cast<uint8_t>(track->encoding));
+            writer.write<uint32_t>(track->size);
+            writer.write<uint32_t>(track->element_size);
+            writer.write<uint8_t>(track->is_signed);
+            writer.write<uint8_t>(track->string);
+            writer.write<uint64_t>(track->count);
+            writer.write<uint64_t>(track->records.size());
+            writer.data.append(track->records);
+        }
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    out.write(writer.data.data(), static_cast<std::streamsize>(writer.data.size()));
+    if (!out)
+    {
+        throw ChangeLogError("failed to write " + path.string());
+    }
+}
+
+ChangeLog ChangeLog::load(const std::filesystem::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        throw ChangeLogError("failed to open " + path.string());
+    }
+
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(MAGIC) || data.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw ChangeLogError("not a change log: " + path.string());
+    }
+
+    Reader reader(data);
+    reader.position = sizeof(MAGIC);
+    auto version = reader.read<uint32_t>();
+    if (version != VERSION)
+    {
+        throw ChangeLogError("unsupported change log version " + std::to_string(version));
+    }
+
+    ChangeLog log;
+    auto table_count = reader.read<uint64_t>();
+    for (uint64_t i = 0; i < table_count; ++i)
+    {
+        Table& table = *log._tables.emplace_back(std::make_unique<Table>());
+        table.server_class = reader.read_string();
+        auto track_count = reader.read<uint64_t>();
+        for (uint64_t j = 0; j < track_count; ++j)
+        {
+            Track& track = *table.tracks.emplace_back(std::make_unique<Track>());
+            track.name = reader.read_string();
+            auto encoding = reader.read<uint8_t>();
+            if (encoding > static_cast<uint8_t>(Track::Encoding::XOR))
+            {
+                throw ChangeLogError("unknown encoding for track " + track.name);
+            }
+            track.encoding = static_cast<Track::Encoding>(encoding);
+            track.size = reader.read<uint32_t>();
+            if (track.encoding == Track::Encoding::XOR && track.size % sizeof(uint32_t) != 0)
+            {
+                throw ChangeLogError("misaligned XOR track " + track.name);
+            }
+            track.element_size = reader.read<uint32_t>();
+            if (track.encoding == Track::Encoding::DELTA)
+            {
+                bool valid = track.element_size == 1 || track.element_size == 4 || track.element_size == 8;
+                if (!valid || track.size == 0 || track.size % track.element_size != 0)
+                {
+                    throw ChangeLogError("misaligned delta track " + track.name);
+                }
+            }
+            track.is_signed = reader.read<uint8_t>() != 0;
+            track.string = reader.read<uint8_t>() != 0;
+            track.count = reader.read<uint64_t>();
+            auto size = reader.read<uint64_t>();
+            reader.require(size);
+            track.records.assign(data, reader.position, size);
+            reader.position += size;
+        }
+    }
+
+    return log;
+}
+
+}
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "../error.h"
+#include "checkpoint.h"
+#include "entity.h"
+
+/// A compact log of every property change, for timelines.
+///
+/// Where the client keeps only the current state of each entity, a change
+/// log keeps every `(tick, id, value)` a property takes on. Records are
+/// appended to one track per property of each server class as entities are
+/// created and updated, and `ChangeLog::series` replays a single track to
+/// reconstruct that property's history without reparsing the demo.
+///
+/// Each record is a varint tick delta, the entity id and the value. Bools
+/// and integers are delta encoded against the entity's previous value, as
+/// is each element of arrays of them. Floats and vectors rarely repeat, so
+/// each of their 32-bit words is XORed with the entity's previous bits
+/// instead; small moves only flip low mantissa bits and make for short
+/// varints. Other values, like strings, are dictionary encoded: a value is
+/// written out in full the first time it is seen and referred to by its
+/// dictionary code after that. The dictionary is rebuilt while reading, so
+/// only the records are stored.
+namespace csgopp::client::change_log
+{
+
+using csgopp::client::checkpoint::Writer;
+using csgopp::client::entity::Entity;
+using csgopp::client::entity::EntityType;
+using object::Type;
+
+class ChangeLogError : public csgopp::error::Error
+{
+    using Error::Error;
+};
+
+/// \brief A value a property took on.
+template<typename T>
+struct Sample
+{
+    uint32_t tick{};
+    Entity::Id id{};
+    T value{};
+};
+
+/// \brief The changes to one property of one server class.
+struct Track
+{
+    enum class Encoding : uint8_t
+    {
+        DELTA,
+        DICTIONARY,
+        XOR,
+    };
+
+    std::string name;
+    Encoding encoding{};
+    /// The size of a delta or XOR encoded value, or of a literal unless `string`.
+    uint32_t size{};
+    /// The size of each integer in a delta encoded value, less than `size`
+    /// for arrays.
+    uint32_t element_size{};
+    bool is_signed{};
+    /// Literals are a length and characters rather than bytes.
+    bool string{};
+    uint64_t count{};
+    std::string records;
+
+    /// Encoding state, which is also reconstructed by `Reader`
+    uint32_t tick{};
+    /// The last integers of each entity's value in delta encoded tracks
+    std::vector<int64_t> previous;
+    /// The last words of each entity's value in XOR-encoded tracks
+    std::vector<uint32_t> previous_bits;
+    std::unordered_map<std::string, uint32_t> codes;
+    /// Null for tracks loaded from disk
+    std::shared_ptr<const Type> type;
+
+    /// \brief A single record as read back from a track.
+    struct Record
+    {
+        uint32_t tick{};
+        Entity::Id id{};
+        /// The value of delta-encoded tracks of single integers
+        int64_t integer{};
+        /// The serialized value of other tracks, valid until the next record
+        /// is read
+        std::string_view literal;
+    };
+
+    /// \brief Replays records in the order they were logged.
+    class Reader
+    {
+    public:
+        explicit Reader(const Track& track) : _track(track)
+        {
+        }
+
+        bool next(Record& record);
+
+    private:
+        const Track& _track;
+        size_t _position{0};
+        uint32_t _tick{0};
+        std::vector<int64_t> _previous;
+        std::vector<uint32_t> _previous_bits;
+        std::vector<std::string_view> _dictionary;
+        std::string _elements;
+
+        uint64_t read_varint();
+    };
+};
+
+class ChangeLog
+{
+public:
+    static constexpr char MAGIC[8] = {'C', 'S', 'G', 'O', 'P', 'P', 'C', 'L'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t DEFAULT_DICTIONARY_SIZE = 1 << 16;
+
+    /// \param dictionary_size the most distinct values each dictionary-encoded
+    ///     track remembers; values seen after it fills up are always written
+    ///     in full.
+    explicit ChangeLog(size_t dictionary_size = DEFAULT_DICTIONARY_SIZE);
+
+    /// \brief Log every property of a newly created entity.
+    void assign(uint32_t tick, const Entity& entity);
+
+    /// \brief Log the properties of an entity that were just decoded.
+    void update(uint32_t tick, const Entity& entity, const std::vector<uint16_t>& indices);
+
+    /// \brief Get the track of a property, if it has ever changed.
+    ///
+    /// \param server_class the name of the server class, e.g. `CCSPlayer`.
+    /// \param property the qualified property name, see `EntityDatum::qualified_name`.
+    [[nodiscard]] const Track* find(std::string_view server_class, std::string_view property) const;
+
+    /// \brief Reconstruct the values a property took on, in order.
+    ///
+    /// Deletions aren't logged, so samples for an id may span several
+    /// entities that held its slot in turn; each one starts with the full
+    /// value logged when it was created.
+    ///
+    /// \tparam T the value type; integral tracks need an integer of the same
+    ///     size, strings need `std::string` and other tracks, including
+    ///     arrays, a trivially copyable type of the same size.
+    /// \param id only return changes to this entity.
+    /// \throws ChangeLogError if `T` doesn't match the track.
+    template<typename T>
+    [[nodiscard]] std::vector<Sample<T>> series(
+        std::string_view server_class,
+        std::string_view property,
+        std::optional<Entity::Id> id = std::nullopt
+    ) const
+    {
+        std::vector<Sample<T>> samples;
+        const Track* track = this->find(server_class, property);
+        if (track == nullptr)
+        {
+            return samples;
+        }
+
+        check<T>(*track);
+        Track::Reader reader(*track);
+        Track::Record record;
+        while (reader.next(record))
+        {
+            if (!id.has_value() || record.id == *id)
+            {
+                samples.push_back(Sample<T>{record.tick, record.id, value<T>(*track, record)});
+            }
+        }
+
+        return samples;
+    }
+
+    /// \brief The number of changes logged.
+    [[nodiscard]] uint64_t size() const;
+
+    /// \brief The bytes of encoded records.
+    [[nodiscard]] size_t bytes() const;
+
+    void clear();
+
+    void save(const std::filesystem::path& path) const;
+    static ChangeLog load(const std::filesystem::path& path);
+
+private:
+    struct Table
+    {
+        std::string server_class;
+        std::vector<std::unique_ptr<Track>> tracks;
+        /// Tracks by prioritized index for `type`, created as needed
+        std::shared_ptr<const EntityType> type;
+        std::vector<Track*> by_index;
+    };
+
+    size_t _dictionary_size;
+    std::vector<std::unique_ptr<Table>> _tables;
+    /// Tables by server class index, rebound when the schema changes
+    std::vector<Table*> _tables_by_class;
+    Writer _scratch;
+
+    Table& table(const Entity& entity);
+    Track& track(Table& table, uint16_t index);
+    void append(Track& track, uint32_t tick, const Entity& entity, uint16_t index);
+
+    template<typename T>
+    static void check(const Track& track)
+    {
+        bool matches;
+        if (track.encoding == Track::Encoding::DELTA && track.element_size == track.size)
+        {
+            matches = std::is_integral_v<T> && sizeof(T) == track.size;
+        }
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+            matches = track.string;
+        }
+        else
+        {
+            matches = std::is_trivially_copyable_v<T> && !track.string && sizeof(T) == track.size;
+        }
+
+        if (!matches)
+        {
+            throw ChangeLogError("wrong value type for track " + track.name);
+        }
+    }
+
+    template<typename T>
+    static T value(const Track& track, const Track::Record& record)
+    {
+        if constexpr (std::is_integral_v<T>)
+        {
+            if (track.encoding == Track::Encoding::DELTA && track.element_size == track.size)
+            {
+                return static_cast<T>(record.integer);
+            }
+        }
+
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            // Written by `Writer` as a length and the characters
+            return std::string(record.literal.substr(sizeof(uint32_t)));
+        }
+        else
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            T result;
+            std::memcpy(&result, record.literal.data(), sizeof(T));
+            return result;
+        }
+    }
+};
+
+}
@@ -0,0 +1,253 @@
+#include "checkpoint.h"
+#include "../common/hash.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace csgopp::client::checkpoint
+{
+
+using object::ArrayType;
+using object::ObjectType;
+using object::ValueType;
+
+void Writer::write(const std::string& value)
+{
+    this->write<uint32_t>(static_cast<uint32_t>(value.size()));
+    this->data.append(value);
+}
+
+void Writer::write(const Type& type, const char* address)
+{
+    if (const auto* object_type = dynamic_cast<const ObjectType*>(&type))
+    {
+        for (const ObjectType::Member& member : *object_type)
+        {
+            this->write(*member.type, address + member.offset);
+        }
+    }
+    else if (const auto* array_type = dynamic_cast<const ArrayType*>(&type))
+    {
+        for (size_t i = 0; i < array_type->length; ++i)
+        {
+            this->write(*array_type->element_type, address + array_type->at(i));
+        }
+    }
+    else if (const auto* value_type = dynamic_cast<const ValueType*>(&type))
+    {
+        if (value_type->info() == typeid(std::string))
+        {
+            this->write(*reinterpret_cast<const std::string*>(address));
+        }
+        else if (value_type->info() == typeid(std::wstring))
+        {
+            const auto& value = *reinterpret_cast<const std::wstring*>(address);
+            this->write<uint32_t>(static_cast<uint32_t>(value.size()));
+            this->data.append(reinterpret_cast<const char*>(value.data()), value.size() * sizeof(wchar_t));
+        }
+        else
+        {
+            this->data.append(address, value_type->size());
+        }
+    }
+    else
+    {
+        throw CheckpointError("cannot checkpoint type " + type.represent());
+    }
+}
+
+void Reader::require(size_t size) const
+{
+    if (this->data.size() - this->position < size)
+    {
+        throw CheckpointError("checkpoint state is truncated");
+    }
+}
+
+std::string Reader::read_string()
+{
+    auto size = this->read<uint32_t>();
+    this->require(size);
+    std::string value(this->data, this->position, size);
+    this->position += size;
+    return value;
+}
+
+void Reader::read(const Type& type, char* address)
+{
+    if (const auto* object_type = dynamic_cast<const ObjectType*>(&type))
+    {
+        for (const ObjectType::Member& member : *object_type)
+        {
+            this->read(*member.type, address + member.offset);
+        }
+    }
+    else if (const auto* array_type = dynamic_cast<const ArrayType*>(&type))
+    {
+        for (size_t i = 0; i < array_type->length; ++i)
+        {
+            this->read(*array_type->element_type, address + array_type->at(i));
+        }
+    }
+    else if (const auto* value_type = dynamic_cast<const ValueType*>(&type))
+    {
+        if (value_type->info() == typeid(std::string))
+        {
+            *reinterpret_cast<std::string*>(address) = this->read_string();
+        }
+        else if (value_type->info() == typeid(std::wstring))
+        {
+            auto size = this->read<uint32_t>();
+            this->require(size * sizeof(wchar_t));
+            auto& value = *reinterpret_cast<std::wstring*>(address);
+            value.resize(size);
+            std::memcpy(value.data(), this->data.data() + this->position, size * sizeof(wchar_t));
+            this->position += size * sizeof(wchar_t);
+        }
+        else
+        {
+            this->require(value_type->size());
+            std::memcpy(address, this->data.data() + this->position, value_type->size());
+            this->position += value_type->size();
+        }
+    }
+    else
+    {
+        throw CheckpointError("cannot restore type " + type.represent());
+    }
+}
+
+DemoIdentity DemoIdentity::of(const std::filesystem::path& demo)
+{
+    std::ifstream in(demo, std::ios::binary);
+    if (!in)
+    {
+        throw CheckpointError("failed to open " + demo.string());
+    }
+
+    std::string sample(SAMPLE_SIZE, '\0');
+    in.read(sample.data(), static_cast<std::streamsize>(sample.size()));
+    sample.resize(static_cast<size_t>(in.gcount()));
+
+    DemoIdentity identity;
+    identity.size = std::filesystem::file_size(demo);
+    identity.hash = csgopp::common::hash::fnv1a(sample);
+    return identity;
+}
+
+void Checkpoints::emplace(Checkpoint&& checkpoint)
+{
+    auto iterator = std::upper_bound(
+        this->_checkpoints.begin(),
+        this->_checkpoints.end(),
+        checkpoint.tick,
+        [](uint32_t tick, const Checkpoint& other) { return tick < other.tick; });
+    this->_checkpoints.insert(iterator, std::move(checkpoint));
+}
+
+const Checkpoint* Checkpoints::before(uint32_t tick) const
+{
+    auto iterator = std::upper_bound(
+        this->_checkpoints.begin(),
+        this->_checkpoints.end(),
+        tick,
+        [](uint32_t tick, const Checkpoint& other) { return tick < other.tick; });
+    return iterator != this->_checkpoints.begin() ? &*std::prev(iterator) : nullptr;
+}
+
+std::filesystem::path Checkpoints::sidecar(const std::filesystem::path& demo)
+{
+    std::filesystem::path path(demo);
+    path += ".checkpoints";
+    return path;
+}
+
+void Checkpoints::save(const std::filesystem::path& path) const
+{
+    Writer writer;
+    writer.data.append(MAGIC, sizeof(MAGIC));
+    writer.write<uint32_t>(VERSION);
+    writer.write<uint64_t>(this->_identity.size);
+    writer.write<uint64_t>(this->_identity.hash);
+    writer.write<uint64_t>(this->_checkpoints.size());
+    for (const Checkpoint& checkpoint : this->_checkpoints)
+    {
+        writer.write<uint32_t>(checkpoint.tick);
+        writer.write<uint32_t>(checkpoint.cursor);
+        writer.write<uint64_t>(checkpoint.offset);
+        writer.write<uint64_t>(checkpoint.state.size());
+        writer.data.append(checkpoint.state);
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    out.write(writer.data.data(), static_cast<std::streamsize>(writer.data.size()));
+    if (!out)
+    {
+        throw CheckpointError("failed to write " + path.string());
+    }
+}
+
+Checkpoints Checkpoints::load(const std::filesystem::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        throw CheckpointError("failed to open " + path.string());
+    }
+
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(MAGIC) || data.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw CheckpointError("not a checkpoint file: " + path.string());
+    }
+
+    Reader reader(data);
+    reader.position = sizeof(MAGIC);
+    auto version = reader.read<uint32_t>();
+    if (version != VERSION)
+    {
+        throw CheckpointError("unsupported checkpoint version " + std::to_string(version));
+    }
+
+    Checkpoints checkpoints;
+    checkpoints._identity.size = reader.read<uint64_t>();
+    checkpoints._identity.hash = reader.read<uint64_t>();
+    auto count = reader.read<uint64_t>();
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        Checkpoint checkpoint;
+        checkpoint.tick = reader.read<uint32_t>();
+        checkpoint.cursor = reader.read<uint32_t>();
+        checkpoint.offset = reader.read<uint64_t>();
+        auto size = reader.read<uint64_t>();
+        reader.require(size);
+        checkpoint.state.assign(data, reader.position, size);
+        reader.position += size;
+        checkpoints.emplace(std::move(checkpoint));
+    }
+
+    return checkpoints;
+}
+
+Checkpoints Checkpoints::load(const std::filesystem::path& path, const DemoIdentity& demo)
+{
+    Checkpoints checkpoints = load(path);
+    if (checkpoints._identity != demo)
+    {
+        throw CheckpointError("checkpoints in " + path.string() + " were taken from a different demo");
+    }
+    return checkpoints;
+}
+
+size_t Checkpoints::bytes() const
+{
+    size_t bytes = 0;
+    for (const Checkpoint& checkpoint : this->_checkpoints)
+    {
+        bytes += checkpoint.state.size();
+    }
+    return bytes;
+}
+
+}
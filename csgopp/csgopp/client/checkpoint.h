@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../error.h"
+#include <object/object.h>
+
+/// Snapshots of client state that can be restored to avoid reparsing.
+///
+/// A checkpoint holds everything the client accumulates while parsing:
+/// string tables, users, game event types and every live entity along with
+/// the byte offset of the next frame. The schema (data tables and server
+/// classes) is not serialized; entities refer to their server class by
+/// index, and a checkpoint can only be restored into a client that has
+/// already built the same schema.
+namespace csgopp::client::checkpoint
+{
+
+using object::Type;
+
+class CheckpointError : public csgopp::error::Error
+{
+    using Error::Error;
+};
+
+/// \brief Append-only binary encoder for checkpoint state.
+struct Writer
+{
+    std::string data;
+
+    template<typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        this->data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void write(const std::string& value);
+
+    /// \brief Encode an object instance by walking its type.
+    ///
+    /// Strings are written as a length and their characters, aggregates are
+    /// walked member by member and all other values are copied verbatim.
+    void write(const Type& type, const char* address);
+};
+
+/// \brief Decoder mirroring `Writer`.
+struct Reader
+{
+    const std::string& data;
+    size_t position{0};
+
+    explicit Reader(const std::string& data) : data(data)
+    {
+    }
+
+    template<typename T>
+    T read()
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        this->require(sizeof(T));
+        T value;
+        std::memcpy(&value, this->data.data() + this->position, sizeof(T));
+        this->position += sizeof(T);
+        return value;
+    }
+
+    std::string read_string();
+
+    /// \brief Decode into a constructed instance of the type.
+    void read(const Type& type, char* address);
+
+    void require(size_t size) const;
+};
+
+struct Checkpoint
+{
+    uint32_t tick{};
+    uint32_t cursor{};
+    /// Byte offset of the next frame from the start of the demo.
+    uint64_t offset{};
+    std::string state;
+};
+
+/// \brief Identifies the demo a set of checkpoints was taken from.
+struct DemoIdentity
+{
+    /// Bytes at the start of the demo that are hashed, covering its header
+    static constexpr size_t SAMPLE_SIZE = 64 * 1024;
+
+    uint64_t size{};
+    uint64_t hash{};
+
+    /// \brief Read the size and hash of a demo on disk.
+    static DemoIdentity of(const std::filesystem::path& demo);
+
+    bool operator==(const DemoIdentity& other) const = default;
+};
+
+/// \brief Checkpoints ordered by tick.
+///
+/// Saved checkpoints carry the identity of their demo, which should be set
+/// with `set_identity` before saving and is checked when loading against
+/// the demo they are meant for.
+class Checkpoints
+{
+public:
+    static constexpr char MAGIC[8] = {'C', 'S', 'G', 'O', 'P', 'P', 'C', 'P'};
+    static constexpr uint32_t VERSION = 1;
+
+    /// \brief Add a checkpoint, keeping the collection sorted by tick.
+    void emplace(Checkpoint&& checkpoint);
+
+    /// \brief Get the latest checkpoint at or before a tick, if any.
+    [[nodiscard]] const Checkpoint* before(uint32_t tick) const;
+
+    /// \brief The conventional sidecar location for a demo's checkpoints.
+    static std::filesystem::path sidecar(const std::filesystem::path& demo);
+
+    void save(const std::filesystem::path& path) const;
+    static Checkpoints load(const std::filesystem::path& path);
+
+    /// \brief Load checkpoints, checking they were taken from a demo.
+    ///
+    /// \throws CheckpointError if they were saved for a different demo.
+    static Checkpoints load(const std::filesystem::path& path, const DemoIdentity& demo);
+
+    void set_identity(const DemoIdentity& identity) { this->_identity = identity; }
+    [[nodiscard]] const DemoIdentity& identity() const { return this->_identity; }
+
+    [[nodiscard]] size_t size() const { return this->_checkpoints.size(); }
+    [[nodiscard]] bool empty() const { return this->_checkpoints.empty(); }
+    [[nodiscard]] const Checkpoint& back() const { return this->_checkpoints.back(); }
+    [[nodiscard]] std::vector<Checkpoint>::const_iterator begin() const { return this->_checkpoints.begin(); }
+    [[nodiscard]] std::vector<Checkpoint>::const_iterator end() const { return this->_checkpoints.end(); }
+
+    /// \brief Get the total size of the serialized state held in memory.
+    [[nodiscard]] size_t bytes() const;
+
+private:
+    std::vector<Checkpoint> _checkpoints;
+    DemoIdentity _identity;
+};
+
+}
@@ -0,0 +1,224 @@
+#include "column_store.h"
+#include "data_table.h"
+
+namespace csgopp::client::column_store
+{
+
+using csgopp::client::entity::EntityDatum;
+using object::ArrayType;
+using object::ObjectType;
+using object::ValueType;
+
+static bool has_strings(const Type& type)
+{
+    if (const auto* object_type = dynamic_cast<const ObjectType*>(&type))
+    {
+        for (const ObjectType::Member& member : *object_type)
+        {
+            if (has_strings(*member.type))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    else if (const auto* array_type = dynamic_cast<const ArrayType*>(&type))
+    {
+        return has_strings(*array_type->element_type);
+    }
+    else if (const auto* value_type = dynamic_cast<const ValueType*>(&type))
+    {
+        return value_type->info() == typeid(std::string);
+    }
+    return true;
+}
+
+/// Count the values of an array or object, if they all have the given type
+static bool count_values(const Type& type, const std::type_info& info, size_t& count)
+{
+    if (const auto* object_type = dynamic_cast<const ObjectType*>(&type))
+    {
+        for (const ObjectType::Member& member : *object_type)
+        {
+            if (!count_values(*member.type, info, count))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    else if (const auto* array_type = dynamic_cast<const ArrayType*>(&type))
+    {
+        for (size_t i = 0; i < array_type->length; ++i)
+        {
+            if (!count_values(*array_type->element_type, info, count))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    else if (const auto* value_type = dynamic_cast<const ValueType*>(&type))
+    {
+        count += 1;
+        return value_type->info() == info;
+    }
+    return false;
+}
+
+ColumnStore::ColumnStore(std::string server_class, std::vector<std::string> properties)
+    : _server_class_name(std::move(server_class))
+    , _property_names(std::move(properties))
+{
+}
+
+void ColumnStore::bind(const std::shared_ptr<const ServerClass>& server_class)
+{
+    std::shared_ptr<const EntityType> type = server_class->data_table->type();
+    if (type == nullptr)
+    {
+        throw ColumnStoreError("server class " + server_class->name + " has no type");
+    }
+
+    std::vector<Column> columns;
+    std::vector<int32_t> columns_by_index(type->prioritized.size(), -1);
+    for (const std::string& name : this->_property_names)
+    {
+        bool found = false;
+        for (size_t i = 0; i < type->prioritized.size(); ++i)
+        {
+            const EntityDatum& datum = type->prioritized[i];
+            if (datum.qualified_name() != name)
+            {
+                continue;
+            }
+
+            if (has_strings(*datum.type))
+            {
+                throw ColumnStoreError("cannot store string property " + name + " by column");
+            }
+
+            columns_by_index[i] = static_cast<int32_t>(columns.size());
+            Column& column = columns.emplace_back();
+            column.name = name;
+            column.type = datum.type;
+            column.offset = datum.offset;
+            column.size = datum.type->size();
+            found = true;
+            break;
+        }
+
+        if (!found)
+        {
+            throw ColumnStoreError("server class " + server_class->name + " has no property " + name);
+        }
+    }
+
+    this->_server_class = server_class;
+    this->_columns = std::move(columns);
+    this->_columns_by_index = std::move(columns_by_index);
+    this->_present.clear();
+}
+
+void ColumnStore::reserve(Entity::Id id)
+{
+    if (id < this->_present.size())
+    {
+        return;
+    }
+
+    this->_present.resize(id + 1);
+    for (Column& column : this->_columns)
+    {
+        column.data.resize(this->_present.size() * column.size);
+    }
+}
+
+void ColumnStore::assign(const Entity& entity)
+{
+    this->reserve(entity.id);
+    this->_present[entity.id] = true;
+
+    const char* address = entity.address.get();
+    for (Column& column : this->_columns)
+    {
+        std::memcpy(column.data.data() + entity.id * column.size, address + column.offset, column.size);
+    }
+}
+
+void ColumnStore::update(const Entity& entity, const std::vector<uint16_t>& indices)
+{
+    this->reserve(entity.id);
+    this->_present[entity.id] = true;
+
+    const char* address = entity.address.get();
+    for (uint16_t index : indices)
+    {
+        int32_t column_index = index < this->_columns_by_index.size() ? this->_columns_by_index[index] : -1;
+        if (column_index >= 0)
+        {
+            Column& column = this->_columns[column_index];
+            std::memcpy(column.data.data() + entity.id * column.size, address + column.offset, column.size);
+        }
+    }
+}
+
+void ColumnStore::erase(Entity::Id id)
+{
+    if (id < this->_present.size())
+    {
+        this->_present[id] = false;
+    }
+}
+
+void ColumnStore::clear()
+{
+    this->_present.clear();
+    for (Column& column : this->_columns)
+    {
+        column.data.clear();
+    }
+}
+
+const Column& ColumnStore::find(std::string_view name) const
+{
+    for (const Column& column : this->_columns)
+    {
+        if (column.name == name)
+        {
+            return column;
+        }
+    }
+
+    throw ColumnStoreError("no column " + std::string(name) + " in store for " + this->_server_class_name);
+}
+
+void ColumnStore::check(
+    const Column& column,
+    size_t size,
+    const std::type_info& info,
+    const std::type_info& element,
+    size_t count
+) const
+{
+    bool matches{false};
+    if (size == column.size)
+    {
+        if (const auto* value_type = dynamic_cast<const ValueType*>(column.type.get()))
+        {
+            matches = value_type->info() == info;
+        }
+        else
+        {
+            size_t values = 0;
+            matches = count_values(*column.type, element, values) && values == count;
+        }
+    }
+
+    if (!matches)
+    {
+        throw ColumnStoreError("wrong value type for column " + column.name);
+    }
+}
+
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include "../error.h"
+#include "entity.h"
+#include "server_class.h"
+
+/// Columnar copies of selected entity properties.
+///
+/// Entities each own a heap blob, so reading one property across every
+/// entity of a class touches a cache line per entity. A column store keeps
+/// chosen properties of one server class in contiguous arrays indexed by
+/// entity id, which the client updates as it decodes, so analytics loops
+/// can run over dense spans instead.
+namespace csgopp::client::column_store
+{
+
+using csgopp::client::entity::Entity;
+using csgopp::client::entity::EntityType;
+using csgopp::client::server_class::ServerClass;
+using object::Type;
+
+class ColumnStoreError : public csgopp::error::Error
+{
+    using Error::Error;
+};
+
+/// \brief One property of every entity in a store.
+struct Column
+{
+    /// The qualified property name, see `EntityDatum::qualified_name`.
+    std::string name;
+    std::shared_ptr<const Type> type;
+    size_t offset{};
+    size_t size{};
+    /// `size` bytes per entity slot.
+    std::vector<std::byte> data;
+};
+
+/// \brief The values `T` holds, for reading array and object columns.
+template<typename T>
+struct Elements
+{
+    using type = T;
+    static constexpr size_t count = 1;
+};
+
+template<typename T, size_t N>
+struct Elements<std::array<T, N>>
+{
+    using type = T;
+    static constexpr size_t count = N;
+};
+
+class ColumnStore
+{
+public:
+    /// \brief Select properties of a server class to store by column.
+    ///
+    /// Nothing is stored until the client has built the server class, at
+    /// which point `bind` resolves the names. Only properties without
+    /// strings can be stored.
+    ColumnStore(std::string server_class, std::vector<std::string> properties);
+
+    /// \brief Resolve the selected properties against a server class.
+    /// \throws ColumnStoreError if a property is missing or holds strings.
+    void bind(const std::shared_ptr<const ServerClass>& server_class);
+
+    /// \brief Copy every selected property of a new or restored entity.
+    void assign(const Entity& entity);
+
+    /// \brief Copy the selected properties among those that changed.
+    void update(const Entity& entity, const std::vector<uint16_t>& indices);
+
+    /// \brief Mark an entity's slot as empty.
+    void erase(Entity::Id id);
+
+    /// \brief Empty every slot, keeping the binding.
+    void clear();
+
+    [[nodiscard]] const std::string& server_class_name() const { return this->_server_class_name; }
+    [[nodiscard]] const std::shared_ptr<const ServerClass>& server_class() const { return this->_server_class; }
+    [[nodiscard]] const std::vector<Column>& columns() const { return this->_columns; }
+
+    /// \brief The number of entity slots, one past the highest id stored.
+    [[nodiscard]] size_t size() const { return this->_present.size(); }
+
+    /// \brief Whether each slot holds a live entity of the class.
+    [[nodiscard]] std::span<const uint8_t> present() const { return this->_present; }
+
+    /// \brief Get a column as a span of values indexed by entity id.
+    ///
+    /// Slots that aren't `present` hold stale or default values.
+    ///
+    /// \tparam T the value type, which must match the property's type.
+    ///     Array and object columns are read as a `std::array` of their
+    ///     values, which must all have the same type.
+    /// \throws ColumnStoreError if the column doesn't exist or `T` doesn't match.
+    template<typename T>
+    [[nodiscard]] std::span<const T> column(std::string_view name) const
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const Column& column = this->find(name);
+        this->check(column, sizeof(T), typeid(T), typeid(typename Elements<T>::type), Elements<T>::count);
+        return std::span<const T>(reinterpret_cast<const T*>(column.data.data()), this->size());
+    }
+
+private:
+    std::string _server_class_name;
+    std::vector<std::string> _property_names;
+    std::shared_ptr<const ServerClass> _server_class;
+    std::vector<Column> _columns;
+    /// Column for each prioritized property index, or -1.
+    std::vector<int32_t> _columns_by_index;
+    std::vector<uint8_t> _present;
+
+    [[nodiscard]] const Column& find(std::string_view name) const;
+    void check(
+        const Column& column,
+        size_t size,
+        const std::type_info& info,
+        const std::type_info& element,
+        size_t count
+    ) const;
+    void reserve(Entity::Id id);
+};
+
+}
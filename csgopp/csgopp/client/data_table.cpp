@@ -1,5 +1,7 @@
 #include "data_table.h"
 
+#include <numeric>
+
 #include "../common/control.h"
 #include "entity.h"
 #include "server_class.h"
@@ -113,21 +115,24 @@ void collect_properties_tail(
     }
 }
 
-void prioritize(std::vector<EntityDatum>& prioritized)
+void prioritize(const std::vector<EntityDatum>& collected, std::vector<uint32_t>& order)
 {
+    order.resize(collected.size());
+    std::iota(order.begin(), order.end(), 0);
+
     size_t start = 0;
     bool more = true;
     for (size_t priority = 0; priority <= 64 || more; ++priority)
     {
         more = false;
-        for (size_t i = start; i < prioritized.size(); ++i)
+        for (size_t i = start; i < order.size(); ++i)
         {
-            const std::shared_ptr<const DataProperty>& property = prioritized[i].property;
+            const std::shared_ptr<const DataProperty>& property = collected[order[i]].property;
             if (property->priority == priority || priority == 64 && property->changes_often())
             {
                 if (start != i)
                 {
-                    std::swap(prioritized[start], prioritized[i]);
+                    std::swap(order[start], order[i]);
                 }
                 start += 1;
             }
@@ -139,15 +144,34 @@ void prioritize(std::vector<EntityDatum>& prioritized)
     }
 }
 
-std::shared_ptr<const EntityType> DataTable::construct_type()
+static bool is_permutation(const std::vector<uint32_t>& order, size_t size)
+{
+    if (order.size() != size)
+    {
+        return false;
+    }
+
+    std::vector<bool> seen(size);
+    for (uint32_t index : order)
+    {
+        if (index >= size || seen[index])
+        {
+            return false;
+        }
+        seen[index] = true;
+    }
+    return true;
+}
+
+std::shared_ptr<const EntityType> DataTable::construct_type(const PrioritizedOrders* orders)
 {
-    if (this->_type == nullptr)
+    std::call_once(this->_type_once, [this, orders]()
     {
         const EntityType* base{nullptr};
         if (this->server_class.lock() && this->server_class.lock()->base_class != nullptr)
         {
             // TODO make this better
-            base = this->server_class.lock()->base_class->data_table->construct_type().get();
+            base = this->server_class.lock()->base_class->data_table->construct_type(orders).get();
         }
 
         EntityType::Builder builder(base);
@@ -160,27 +184,51 @@ std::shared_ptr<const EntityType> DataTable::construct_type()
 
         auto entity_type = std::make_shared<EntityType>(std::move(builder));
 
-        // Create prioritized
+        // Collect, then create prioritized
         entity_type->prioritized.reserve(entity_type->members.size());
         absl::flat_hash_set<ExcludeView> accumulated_excludes;
         collect_properties_tail(entity_type, this, 0, nullptr, accumulated_excludes);
-        prioritize(entity_type->prioritized);
+        std::vector<EntityDatum> collected = std::move(entity_type->prioritized);
 
-        // Assign
-        this->_type = entity_type;
-    }
+        const std::vector<uint32_t>* cached{nullptr};
+        if (orders != nullptr)
+        {
+            auto iterator = orders->find(this->name);
+            cached = iterator != orders->end() ? &iterator->second : nullptr;
+        }
+
+        if (cached != nullptr && is_permutation(*cached, collected.size()))
+        {
+            this->_prioritized_order = *cached;
+        }
+        else
+        {
+            prioritize(collected, this->_prioritized_order);
+        }
 
-    return this->_type;
+        entity_type->prioritized.clear();
+        entity_type->prioritized.reserve(collected.size());
+        for (uint32_t index : this->_prioritized_order)
+        {
+            entity_type->prioritized.emplace_back(std::move(collected[index]));
+        }
+        entity_type->compile();
+
+        // Published last so readers of type() also see the prioritized order
+        this->_type.store(entity_type, std::memory_order_release);
+    });
+
+    return this->_type.load(std::memory_order_acquire);
 }
 
 std::shared_ptr<const EntityType> DataTable::type() const
 {
-    return this->_type;
+    return this->_type.load(std::memory_order_acquire);
 }
 
 std::shared_ptr<const ArrayType> DataTable::construct_array_type()
 {
-    if (this->_array_type == nullptr)
+    std::call_once(this->_array_type_once, [this]()
     {
         std::shared_ptr<const Type> element_type = this->properties.at(0)->construct_type();
 
@@ -193,7 +241,7 @@ std::shared_ptr<const ArrayType> DataTable::construct_array_type()
 
         size_t array_size = this->properties.size();
         this->_array_type = std::make_shared<ArrayType>(element_type, array_size);
-    }
+    });
 
     return this->_array_type;
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <variant>
 #include <absl/container/flat_hash_map.h>
 #include <google/protobuf/io/coded_stream.h>
@@ -47,6 +50,9 @@ using object::code::Definition;
 
 using Exclude = std::pair<std::string, std::string>;
 
+/// \brief Prioritized property orders by data table name.
+using PrioritizedOrders = absl::flat_hash_map<std::string, std::vector<uint32_t>>;
+
 /// \brief A collection of properties that mirror a send/receive table.
 ///
 /// Data tables are a core part of the source engine's data low-latency data
@@ -148,15 +154,33 @@ struct DataTable : Context<Definition>
     explicit DataTable(const CSVCMsg_SendTable& data);
 
     /// \brief Construct the underlying EntityType of this data table.
-    std::shared_ptr<const EntityType> construct_type();
+    ///
+    /// The type is only built once, even if several threads ask for it at
+    /// the same time; if construction throws, the next call tries again.
+    ///
+    /// \param orders prioritized orders from an earlier construction of the
+    ///     same schema, see `prioritized_order`. Data tables missing from it
+    ///     or whose order doesn't fit are prioritized from scratch.
+    std::shared_ptr<const EntityType> construct_type(const PrioritizedOrders* orders = nullptr);
 
     /// \brief Return the constructed type; not possible to guarantee this statically.
     ///
+    /// Safe to call while another thread constructs the type, in which case
+    /// it may still be null.
+    ///
     /// \return a shared pointer to the allocated type.
     [[nodiscard]] std::shared_ptr<const EntityType> type() const;
 
+    /// \brief The collected index of each prioritized property.
+    ///
+    /// Properties are collected in declaration order and then sorted by
+    /// priority; this records the result so it can be cached.
+    [[nodiscard]] const std::vector<uint32_t>& prioritized_order() const { return this->_prioritized_order; }
+
     /// \brief Build an array entity type from the data table properties.
     ///
+    /// Like `construct_type`, this only happens once.
+    ///
     /// \return a shared pointer to the allocated type.
     std::shared_ptr<const ArrayType> construct_array_type();
 
@@ -166,8 +190,12 @@ struct DataTable : Context<Definition>
     void apply(Cursor<Definition> cursor) const override;
 
 private:
-    std::shared_ptr<const EntityType> _type;
+    std::once_flag _type_once;
+    /// Atomic since schemas may be shared while other clients construct it
+    std::atomic<std::shared_ptr<const EntityType>> _type;
+    std::once_flag _array_type_once;
     std::shared_ptr<const ArrayType> _array_type;
+    std::vector<uint32_t> _prioritized_order;
 };
 
 using DataTableDatabase = DatabaseWithName<DataTable>;
@@ -11,6 +11,7 @@ namespace csgopp::client::data_table::data_property
 using csgopp::client::data_table::data_type::BoolType;
 using csgopp::client::data_table::data_type::DataArrayType;
 using csgopp::client::data_table::data_type::FloatType;
+using csgopp::client::data_table::data_type::InlineStringType;
 using csgopp::client::data_table::data_type::SignedInt32Type;
 using csgopp::client::data_table::data_type::SignedInt64Type;
 using csgopp::client::data_table::data_type::StringType;
@@ -149,6 +150,12 @@ bool Vector2Property::equals(const Property* other) const
     return true;
 }
 
+StringProperty::StringProperty(CSVCMsg_SendTable_sendprop_t&& data, bool inline_layout)
+    : DataProperty(std::move(data))
+    , inline_layout(inline_layout)
+{
+}
+
 Property::Kind::T StringProperty::kind() const
 {
     return Kind::STRING;
@@ -161,6 +168,10 @@ std::shared_ptr<const Type> StringProperty::construct_type()
 
 std::shared_ptr<const DataType> StringProperty::type() const
 {
+    if (this->inline_layout)
+    {
+        return shared<InlineStringType>();
+    }
     return shared<StringType>();
 }
 
@@ -168,7 +179,7 @@ bool StringProperty::equals(const Property* other) const
 {
     GUARD(this->flags == other->flags);
     CAST(as, StringProperty, other);
-    return true;
+    return EQUAL(as, inline_layout);
 }
 
 ArrayProperty::ArrayProperty(CSVCMsg_SendTable_sendprop_t&& data, std::unique_ptr<DataProperty>&& element)
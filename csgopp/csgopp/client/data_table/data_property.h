@@ -104,9 +104,15 @@ struct Vector2Property final : public DataProperty
 };
 
 /// \brief Represents a string of arbitrary length.
+///
+/// With `inline_layout` the value is stored as a fixed-size `InlineString`
+/// rather than a `std::string`, so entities containing it stay trivially
+/// copyable and updates never allocate.
 struct StringProperty final : public DataProperty
 {
-    using DataProperty::DataProperty;
+    bool inline_layout;
+
+    explicit StringProperty(CSVCMsg_SendTable_sendprop_t&& data, bool inline_layout = false);
 
     [[nodiscard]] Kind::T kind() const override;
 
@@ -1,49 +1,21 @@
 #include "data_type.h"
 #include "data_property.h"
+#include "decode.h"
 #include "../data_table.h"
 
 namespace csgopp::client::data_table::data_type
 {
 
 using csgopp::client::data_table::data_property::ArrayProperty;
+using csgopp::client::data_table::data_property::FloatProperty;
 using csgopp::client::data_table::data_property::Int32Property;
 using csgopp::client::data_table::data_property::Int64Property;
+using csgopp::client::data_table::data_property::Vector2Property;
+using csgopp::client::data_table::data_property::Vector3Property;
+using csgopp::client::data_table::decode::FloatEncoding;
 using csgopp::common::vector::Vector2;
 using csgopp::common::vector::Vector3;
 
-// https://github.com/ValveSoftware/source-sdk-2013/blob/master/mp/src/public/dt_common.h
-
-namespace coordinates
-{
-const size_t FRACTIONAL_BITS_MP = 5;
-const size_t FRACTIONAL_BITS_MP_LOW_PRECISION = 3;
-const size_t DENOMINATOR = 1 << FRACTIONAL_BITS_MP;
-const float RESOLUTION = 1.0 / DENOMINATOR;
-const size_t DENOMINATOR_LOW_PRECISION = 1 << FRACTIONAL_BITS_MP_LOW_PRECISION;
-const float RESOLUTION_LOW_PRECISION = 1.0 / DENOMINATOR_LOW_PRECISION;
-const size_t INTEGER_BITS_MP = 11;
-const size_t INTEGER_BITS = 14;
-}
-
-namespace normal
-{
-const size_t FRACTION_BITS = 11;
-const size_t DENOMINATOR = (1 << FRACTION_BITS) - 1;
-const float RESOLUTION = 1.0 / DENOMINATOR;
-}
-
-namespace string
-{
-const size_t STRING_SIZE_BITS_MAX = 9;
-const uint32_t STRING_SIZE_MAX = 1 << STRING_SIZE_BITS_MAX;
-}
-
-enum struct Precision
-{
-    Normal,
-    Low,
-};
-
 void BoolType::emit(Cursor<Declaration>& cursor) const
 {
     cursor.target.type = "bool";
@@ -51,9 +23,7 @@ void BoolType::emit(Cursor<Declaration>& cursor) const
 
 void BoolType::update(char* address, BitStream& stream, const Property* property) const
 {
-    uint8_t value;
-    OK(stream.read(&value, 1));
-    *reinterpret_cast<bool*>(address) = value;
+    *reinterpret_cast<bool*>(address) = decode::read_bool(stream);
 }
 
 void BoolType::format(const char* address, std::ostream& out) const
@@ -66,65 +36,18 @@ void UnsignedInt32Type::emit(Cursor<Declaration>& cursor) const
     cursor.target.type = "uint32_t";
 }
 
-template<typename T>
-inline void update_int_variable(char* address, BitStream& stream)
-{
-    stream.read_variable_unsigned_int(reinterpret_cast<T*>(address));
-}
-
-template<typename T, typename Underlying>
-inline void update_int_fixed(char* address, BitStream& stream, const Property* property)
-{
-    const auto* int_property = reinterpret_cast<const Underlying*>(property);
-    OK(int_property != nullptr);
-    OK(stream.read(reinterpret_cast<T*>(address), int_property->bits));
-}
-
-template<>
-inline void update_int_fixed<int32_t, Int32Property>(
-    char* address,
-    BitStream& stream,
-    const Property* property
-)
-{
-    const auto* int_property = reinterpret_cast<const Int32Property*>(property);
-    int32_t& value = *reinterpret_cast<int32_t*>(address);
-    OK(int_property != nullptr);
-    OK(stream.read(&value, int_property->bits));
-
-    // Sign extend
-    value <<= 32 - int_property->bits;
-    value >>= 32 - int_property->bits;
-}
-
-template<>
-inline void update_int_fixed<int64_t, Int64Property>(
-    char* address,
-    BitStream& stream,
-    const Property* property
-)
-{
-    const auto* int_property = reinterpret_cast<const Int64Property*>(property);
-    int64_t& value = *reinterpret_cast<int64_t*>(address);
-    uint8_t is_negative;
-    OK(stream.read(&is_negative, 1));
-    OK(stream.read(&value, int_property->bits));
-
-    if (is_negative)
-    {
-        value = -value;
-    }
-}
+// The property passed to each type is the one that created it, so the casts below are safe
 
 void UnsignedInt32Type::update(char* address, BitStream& stream, const Property* property) const
 {
+    auto& value = *reinterpret_cast<uint32_t*>(address);
     if (property->flags & Property::Flags::VARIABLE_INTEGER)
     {
-        update_int_variable<uint32_t>(address, stream);
+        value = decode::read_int_variable<uint32_t>(stream);
     }
     else
     {
-        update_int_fixed<uint32_t, DataTable::Int32Property>(address, stream, property);
+        value = decode::read_int_fixed<uint32_t>(stream, static_cast<const Int32Property*>(property)->bits);
     }
 }
 
@@ -140,13 +63,14 @@ void SignedInt32Type::emit(Cursor<Declaration>& cursor) const
 
 void SignedInt32Type::update(char* address, BitStream& stream, const Property* property) const
 {
+    auto& value = *reinterpret_cast<int32_t*>(address);
     if (property->flags & Property::Flags::VARIABLE_INTEGER)
     {
-        update_int_variable<int32_t>(address, stream);
+        value = decode::read_int_variable<int32_t>(stream);
     }
     else
     {
-        update_int_fixed<int32_t, DataTable::Int32Property>(address, stream, property);
+        value = decode::read_int32_signed(stream, static_cast<const Int32Property*>(property)->bits);
     }
 }
 
@@ -160,258 +84,21 @@ void FloatType::emit(Cursor<Declaration>& cursor) const
     cursor.target.type = "float";
 }
 
-inline void update_float_coordinates(char* address, BitStream& stream)
-{
-    // Always clear value to zero; if we get no data it means zero
-    float& value = *reinterpret_cast<float*>(address);
-    value = 0;
-
-    uint8_t has_integral;
-    OK(stream.read(&has_integral, 1));
-
-    uint8_t has_fractional;
-    OK(stream.read(&has_fractional, 1));
-
-    if (has_integral || has_fractional)
-    {
-        uint8_t is_negative;
-        OK(stream.read(&is_negative, 1));
-
-        // INTEGER_BITS and FRACTIONAL_BITS_MP are < 16
-        uint16_t buffer;
-
-        if (has_integral)
-        {
-            OK(stream.read(&buffer, coordinates::INTEGER_BITS));
-            value += static_cast<float>(buffer) + 1;
-        }
-
-        if (has_fractional)
-        {
-            OK(stream.read(&buffer, coordinates::FRACTIONAL_BITS_MP));
-            value += static_cast<float>(buffer) * coordinates::RESOLUTION;
-        }
-
-        if (is_negative)
-        {
-            value = -value;
-        }
-    }
-}
-
-inline void update_float_normal(char* address, BitStream& stream)
-{
-    uint8_t is_negative;
-    OK(stream.read(&is_negative, 1));
-
-    uint16_t buffer;
-    OK(stream.read(&buffer, normal::FRACTION_BITS));
-
-    float& value = *reinterpret_cast<float*>(address);
-    value = static_cast<float>(buffer) * normal::RESOLUTION;
-
-    if (is_negative)
-    {
-        value = -value;
-    }
-}
-
-template<Precision P = Precision::Normal>
-inline void update_float_coordinates_multiplayer(char* address, BitStream& stream)
-{
-    // Always clear value to zero; if we get no data it means zero
-    float& value = *reinterpret_cast<float*>(address);
-    value = 0;
-
-    uint8_t is_in_bounds;
-    OK(stream.read(&is_in_bounds, 1));
-
-    uint8_t has_integral;
-    OK(stream.read(&has_integral, 1));
-
-    uint8_t is_negative;
-    OK(stream.read(&is_negative, 1));
-
-    if (has_integral)
-    {
-        int16_t buffer;
-        if (is_in_bounds)
-        {
-            OK(stream.read(&buffer, coordinates::INTEGER_BITS_MP));
-        }
-        else
-        {
-            OK(stream.read(&buffer, coordinates::INTEGER_BITS));
-        }
-
-        value += static_cast<float>(buffer);
-    }
-
-    if constexpr (P == Precision::Low)
-    {
-        uint8_t buffer;
-        OK(stream.read(&buffer, coordinates::FRACTIONAL_BITS_MP_LOW_PRECISION));
-        value += static_cast<float>(buffer) * coordinates::RESOLUTION_LOW_PRECISION;
-    }
-    else
-    {
-        uint8_t buffer;
-        OK(stream.read(&buffer, coordinates::FRACTIONAL_BITS_MP));
-        value += static_cast<float>(buffer) * coordinates::RESOLUTION;
-    }
-
-    if (is_negative)
-    {
-        value = -value;
-    }
-}
-
-inline void update_float_coordinates_multiplayer_integral(char* address, BitStream& stream)
-{
-    // Always clear value to zero; if we get no data it means zero
-    float& value = *reinterpret_cast<float*>(address);
-    value = 0;
-
-    uint8_t is_in_bounds;
-    OK(stream.read(&is_in_bounds, 1));
-
-    uint8_t is_non_zero;
-    OK(stream.read(&is_non_zero, 1));
-
-    if (is_non_zero)
-    {
-        uint8_t is_negative;
-        OK(stream.read(&is_negative, 1));
-
-        int16_t buffer;
-        if (is_in_bounds)
-        {
-            OK(stream.read(&buffer, coordinates::INTEGER_BITS_MP));
-        }
-        else
-        {
-            OK(stream.read(&buffer, coordinates::INTEGER_BITS));
-        }
-
-        value = static_cast<float>(buffer);
-
-        if (is_negative)
-        {
-            value = -value;
-        }
-    }
-}
-
-template<typename Underlying, Precision P = Precision::Normal>
-inline void update_float_cell_coordinates(char* address, BitStream& stream, const Property* property)
-{
-    float& value = *reinterpret_cast<float*>(address);
-
-    // TODO: these should be static, we guarantee theem externally
-    const auto* float_property = dynamic_cast<const Underlying*>(property);
-    assert(float_property != nullptr);
-
-    uint32_t buffer;
-    OK(stream.read(&buffer, float_property->bits));
-    value = static_cast<float>(buffer);
-
-    if constexpr (P == Precision::Low)
-    {
-        OK(stream.read(&buffer, coordinates::FRACTIONAL_BITS_MP_LOW_PRECISION));
-        value += static_cast<float>(buffer) * coordinates::RESOLUTION_LOW_PRECISION;
-    }
-    else
-    {
-        OK(stream.read(&buffer, coordinates::FRACTIONAL_BITS_MP));
-        value += static_cast<float>(buffer) * coordinates::RESOLUTION;
-    }
-}
-
-template<typename Underlying>
-inline void update_float_cell_coordinates_integral(char* address, BitStream& stream, const Property* property)
-{
-    float& value = *reinterpret_cast<float*>(address);
-
-    const auto* float_property = dynamic_cast<const Underlying*>(property);
-    assert(float_property != nullptr);
-
-    uint32_t buffer;
-    OK(stream.read(&buffer, float_property->bits));
-    *reinterpret_cast<float*>(address) = static_cast<float>(buffer);
-}
-
-inline void update_float_no_scale(char* address, BitStream& stream)
-{
-    // Yes, it's a float, but our read only works with integral types; just use the same size
-    OK(stream.read(reinterpret_cast<uint32_t*>(address), 32));
-}
-
-constexpr float interpolate(float a, float b, float x)
-{
-    return a + (b - a) * x;
-}
-
 template<typename Underlying>
-inline void update_float_scaled(char* address, BitStream& stream, const Property* property)
-{
-    const auto* float_property = dynamic_cast<const Underlying*>(property);
-    assert(float_property != nullptr);
-
-    uint32_t buffer;
-    OK(stream.read(&buffer, float_property->bits));
-    *reinterpret_cast<float*>(address) = interpolate(
-        float_property->low_value,
-        float_property->high_value,
-        static_cast<float>(buffer) / static_cast<float>((1 << float_property->bits) - 1));
-}
-
-template<typename Underlying = DataTable::FloatProperty>
-inline void update_float(char* address, BitStream& stream, const Property* property)
+inline float update_float(BitStream& stream, const Property* property)
 {
-    if (property->flags & Property::Flags::NO_SCALE && !(property->flags & Property::Flags::HIGH_PRIORITY_FLOAT_FLAGS))
+    const auto* float_property = static_cast<const Underlying*>(property);
+    FloatEncoding encoding = decode::classify_float(property->flags);
+    if (encoding == FloatEncoding::INVALID)
     {
-        update_float_no_scale(address, stream);
-    }
-    else
-    {
-        switch (property->flags & Property::Flags::FLOAT_FLAGS)
-        {
-            using Flags = Property::Flags;
-        case 0:update_float_scaled<Underlying>(address, stream, property);
-            break;
-        case Flags::COORDINATES:update_float_coordinates(address, stream);
-            break;
-        case Flags::NORMAL:update_float_normal(address, stream);
-            break;
-        case Flags::COORDINATES_MULTIPLAYER:update_float_coordinates_multiplayer(address, stream);
-            break;
-        case Flags::COORDINATES_MULTIPLAYER_LOW_PRECISION:
-            update_float_coordinates_multiplayer<Precision::Low>(
-                address, stream
-            );
-            break;
-        case Flags::COORDINATES_MULTIPLAYER_INTEGRAL:update_float_coordinates_multiplayer_integral(address, stream);
-            break;
-        case Flags::CELL_COORDINATES:update_float_cell_coordinates<Underlying>(address, stream, property);
-            break;
-        case Flags::CELL_COORDINATES_LOW_PRECISION:
-            update_float_cell_coordinates<Underlying, Precision::Low>(
-                address, stream, property
-            );
-            break;
-        case Flags::CELL_COORDINATES_INTEGRAL:
-            update_float_cell_coordinates_integral<Underlying>(
-                address, stream, property
-            );
-            break;
-        default:throw csgopp::error::GameError("invalid float flag set " + std::to_string(property->flags));
-        }
+        throw csgopp::error::GameError("invalid float flag set " + std::to_string(property->flags));
     }
+    return decode::read_float(stream, encoding, float_property->bits, float_property->low_value, float_property->high_value);
 }
 
 void FloatType::update(char* address, BitStream& stream, const Property* property) const
 {
-    update_float(address, stream, property);
+    *reinterpret_cast<float*>(address) = update_float<FloatProperty>(stream, property);
 }
 
 void FloatType::format(const char* address, std::ostream& out) const
@@ -427,8 +114,8 @@ void Vector3Type::emit(Cursor<Declaration>& cursor) const
 void Vector3Type::update(char* address, BitStream& stream, const Property* property) const
 {
     auto* value = reinterpret_cast<Vector3*>(address);
-    update_float<DataTable::Vector3Property>(reinterpret_cast<char*>(&value->x), stream, property);
-    update_float<DataTable::Vector3Property>(reinterpret_cast<char*>(&value->y), stream, property);
+    value->x = update_float<Vector3Property>(stream, property);
+    value->y = update_float<Vector3Property>(stream, property);
 
     if (property->flags & Property::Flags::NORMAL)
     {
@@ -451,7 +138,7 @@ void Vector3Type::update(char* address, BitStream& stream, const Property* prope
     }
     else
     {
-        update_float<DataTable::Vector3Property>(reinterpret_cast<char*>(&value->z), stream, property);
+        value->z = update_float<Vector3Property>(stream, property);
     }
 }
 
@@ -468,9 +155,9 @@ void Vector2Type::emit(Cursor<Declaration>& cursor) const
 
 void Vector2Type::update(char* address, BitStream& stream, const Property* property) const
 {
-    auto* value = reinterpret_cast<Vector3*>(address);
-    update_float<DataTable::Vector3Property>(reinterpret_cast<char*>(&value->x), stream, property);
-    update_float<DataTable::Vector3Property>(reinterpret_cast<char*>(&value->y), stream, property);
+    auto* value = reinterpret_cast<Vector2*>(address);
+    value->x = update_float<Vector2Property>(stream, property);
+    value->y = update_float<Vector2Property>(stream, property);
 }
 
 void Vector2Type::format(const char* address, std::ostream& out) const
@@ -486,11 +173,7 @@ void StringType::emit(Cursor<Declaration>& cursor) const
 
 void StringType::update(char* address, BitStream& stream, const Property* property) const
 {
-    std::string& value = *reinterpret_cast<std::string*>(address);
-
-    uint32_t size;
-    stream.read(&size, string::STRING_SIZE_BITS_MAX);
-    stream.read_string_from(value, std::min(string::STRING_SIZE_MAX, size));
+    decode::read_string(stream, *reinterpret_cast<std::string*>(address));
 }
 
 void StringType::format(const char* address, std::ostream& out) const
@@ -498,6 +181,21 @@ void StringType::format(const char* address, std::ostream& out) const
     out << "\"" << *reinterpret_cast<const Value*>(address) << "\"";
 }
 
+void InlineStringType::emit(Cursor<Declaration>& cursor) const
+{
+    cursor.target.type = "InlineString";
+}
+
+void InlineStringType::update(char* address, BitStream& stream, const Property* property) const
+{
+    decode::read_string(stream, *reinterpret_cast<InlineString*>(address));
+}
+
+void InlineStringType::format(const char* address, std::ostream& out) const
+{
+    out << "\"" << reinterpret_cast<const Value*>(address)->view() << "\"";
+}
+
 void UnsignedInt64Type::emit(Cursor<Declaration>& cursor) const
 {
     cursor.target.type = "uint64_t";
@@ -505,13 +203,14 @@ void UnsignedInt64Type::emit(Cursor<Declaration>& cursor) const
 
 void UnsignedInt64Type::update(char* address, BitStream& stream, const Property* property) const
 {
+    auto& value = *reinterpret_cast<uint64_t*>(address);
     if (property->flags & Property::Flags::VARIABLE_INTEGER)
     {
-        update_int_variable<uint64_t>(address, stream);
+        value = decode::read_int_variable<uint64_t>(stream);
     }
     else
     {
-        update_int_fixed<uint64_t, DataTable::Int64Property>(address, stream, property);
+        value = decode::read_int_fixed<uint64_t>(stream, static_cast<const Int64Property*>(property)->bits);
     }
 }
 
@@ -527,13 +226,14 @@ void SignedInt64Type::emit(Cursor<Declaration>& cursor) const
 
 void SignedInt64Type::update(char* address, BitStream& stream, const Property* property) const
 {
+    auto& value = *reinterpret_cast<int64_t*>(address);
     if (property->flags & Property::Flags::VARIABLE_INTEGER)
     {
-        update_int_variable<int64_t>(address, stream);
+        value = decode::read_int_variable<int64_t>(stream);
     }
     else
     {
-        update_int_fixed<int64_t, DataTable::Int64Property>(address, stream, property);
+        value = decode::read_int64_signed(stream, static_cast<const Int64Property*>(property)->bits);
     }
 }
 
@@ -544,8 +244,7 @@ void SignedInt64Type::format(const char* address, std::ostream& out) const
 
 void DataArrayType::update(char* address, BitStream& stream, const Property* property) const
 {
-    const auto* array_property = dynamic_cast<const ArrayProperty*>(property);
-    assert(array_property != nullptr);
+    const auto* array_property = static_cast<const ArrayProperty*>(property);
 
     // Count how many elements we're receiving
     uint8_t size_bits = common::bits::width(this->length) + 1;
@@ -555,7 +254,7 @@ void DataArrayType::update(char* address, BitStream& stream, const Property* pro
 
     // Inner type cannot be an object; this has to be a runtime invariant
     const auto* value_type = dynamic_cast<const DataType*>(this->element_type.get());
-    assert(value_type != nullptr);
+    OK(value_type != nullptr);
 
     for (size_t i = 0; i < data_length; ++i)
     {
@@ -4,11 +4,13 @@
 #include <object/object.h>
 #include "../../common/bits.h"
 #include "../../common/vector.h"
+#include "decode.h"
 #include "property.h"
 
 namespace csgopp::client::data_table::data_type
 {
 
+using csgopp::client::data_table::decode::InlineString;
 using csgopp::client::data_table::property::Property;
 using csgopp::common::bits::BitStream;
 using csgopp::common::vector::Vector2;
@@ -74,6 +76,14 @@ struct StringType final : public DefaultValueType<std::string>, public virtual D
     void format(const char* address, std::ostream& out) const override;
 };
 
+/// \brief A string property laid out as an `InlineString`.
+struct InlineStringType final : public DefaultValueType<InlineString>, public virtual DataType
+{
+    void emit(Cursor<Declaration>& cursor) const override;
+    void update(char* address, BitStream& stream, const Property* property) const override;
+    void format(const char* address, std::ostream& out) const override;
+};
+
 struct UnsignedInt64Type final : public DefaultValueType<uint64_t>, public virtual DataType
 {
     void emit(Cursor<Declaration>& cursor) const override;
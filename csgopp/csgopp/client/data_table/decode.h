@@ -0,0 +1,401 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "../../common/bits.h"
+#include "../../common/macro.h"
+#include "../../error.h"
+#include "property.h"
+
+/// Primitive decoders for networked property values.
+///
+/// These are shared by the virtual `DataType::update` implementations and
+/// the compiled `DecodePlan` interpreter so both produce identical values.
+///
+/// \sa https://github.com/ValveSoftware/source-sdk-2013/blob/master/mp/src/public/dt_common.h
+namespace csgopp::client::data_table::decode
+{
+
+using csgopp::client::data_table::property::PropertyFlags;
+using csgopp::common::bits::BitStream;
+
+namespace coordinates
+{
+const size_t FRACTIONAL_BITS_MP = 5;
+const size_t FRACTIONAL_BITS_MP_LOW_PRECISION = 3;
+const size_t DENOMINATOR = 1 << FRACTIONAL_BITS_MP;
+const float RESOLUTION = 1.0 / DENOMINATOR;
+const size_t DENOMINATOR_LOW_PRECISION = 1 << FRACTIONAL_BITS_MP_LOW_PRECISION;
+const float RESOLUTION_LOW_PRECISION = 1.0 / DENOMINATOR_LOW_PRECISION;
+const size_t INTEGER_BITS_MP = 11;
+const size_t INTEGER_BITS = 14;
+}
+
+namespace normal
+{
+const size_t FRACTION_BITS = 11;
+const size_t DENOMINATOR = (1 << FRACTION_BITS) - 1;
+const float RESOLUTION = 1.0 / DENOMINATOR;
+}
+
+namespace string
+{
+const size_t STRING_SIZE_BITS_MAX = 9;
+const uint32_t STRING_SIZE_MAX = 1 << STRING_SIZE_BITS_MAX;
+}
+
+/// \brief A networked string stored in a fixed buffer.
+///
+/// Unlike `std::string`, this is trivially copyable and never allocates,
+/// at the cost of `STRING_SIZE_MAX` bytes per property. The contents are
+/// always terminated so `data` can be passed as a C string.
+struct InlineString
+{
+    uint16_t size{0};
+    char data[string::STRING_SIZE_MAX + 1]{};
+
+    [[nodiscard]] std::string_view view() const { return {this->data, this->size}; }
+    bool operator==(const InlineString& other) const { return this->view() == other.view(); }
+};
+
+static_assert(std::is_trivially_copyable_v<InlineString>);
+
+enum struct Precision
+{
+    Normal,
+    Low,
+};
+
+constexpr float interpolate(float a, float b, float x)
+{
+    return a + (b - a) * x;
+}
+
+inline bool read_bool(BitStream& stream)
+{
+    uint8_t value;
+    OK(stream.read(&value, 1));
+    return value;
+}
+
+template<typename T>
+inline T read_int_variable(BitStream& stream)
+{
+    T value;
+    stream.read_variable_unsigned_int(&value);
+    return value;
+}
+
+template<typename T>
+inline T read_int_fixed(BitStream& stream, size_t bits)
+{
+    T value;
+    OK(stream.read(&value, bits));
+    return value;
+}
+
+inline int32_t read_int32_signed(BitStream& stream, size_t bits)
+{
+    int32_t value;
+    OK(stream.read(&value, bits));
+
+    // Sign extend
+    value <<= 32 - bits;
+    value >>= 32 - bits;
+    return value;
+}
+
+inline int64_t read_int64_signed(BitStream& stream, size_t bits)
+{
+    uint8_t is_negative;
+    OK(stream.read(&is_negative, 1));
+    int64_t value;
+    OK(stream.read(&value, bits));
+    return is_negative ? -value : value;
+}
+
+inline float read_float_coordinates(BitStream& stream)
+{
+    // Always clear value to zero; if we get no data it means zero
+    float value = 0;
+
+    uint8_t has_integral;
+    OK(stream.read(&has_integral, 1));
+
+    uint8_t has_fractional;
+    OK(stream.read(&has_fractional, 1));
+
+    if (has_integral || has_fractional)
+    {
+        uint8_t is_negative;
+        OK(stream.read(&is_negative, 1));
+
+        // INTEGER_BITS and FRACTIONAL_BITS_MP are < 16
+        uint16_t buffer;
+
+        if (has_integral)
+        {
+            OK(stream.read(&buffer, coordinates::INTEGER_BITS));
+            value += static_cast<float>(buffer) + 1;
+        }
+
+        if (has_fractional)
+        {
+            OK(stream.read(&buffer, coordinates::FRACTIONAL_BITS_MP));
+            value += static_cast<float>(buffer) * coordinates::RESOLUTION;
+        }
+
+        if (is_negative)
+        {
+            value = -value;
+        }
+    }
+
+    return value;
+}
+
+inline float read_float_normal(BitStream& stream)
+{
+    uint8_t is_negative;
+    OK(stream.read(&is_negative, 1));
+
+    uint16_t buffer;
+    OK(stream.read(&buffer, normal::FRACTION_BITS));
+
+    float value = static_cast<float>(buffer) * normal::RESOLUTION;
+    return is_negative ? -value : value;
+}
+
+template<Precision P = Precision::Normal>
+inline float read_float_coordinates_multiplayer(BitStream& stream)
+{
+    // Always clear value to zero; if we get no data it means zero
+    float value = 0;
+
+    uint8_t is_in_bounds;
+    OK(stream.read(&is_in_bounds, 1));
+
+    uint8_t has_integral;
+    OK(stream.read(&has_integral, 1));
+
+    uint8_t is_negative;
+    OK(stream.read(&is_negative, 1));
+
+    if (has_integral)
+    {
+        int16_t buffer;
+        if (is_in_bounds)
+        {
+            OK(stream.read(&buffer, coordinates::INTEGER_BITS_MP));
+        }
+        else
+        {
+            OK(stream.read(&buffer, coordinates::INTEGER_BITS));
+        }
+
+        value += static_cast<float>(buffer);
+    }
+
+    if constexpr (P == Precision::Low)
+    {
+        uint8_t buffer;
+        OK(stream.read(&buffer, coordinates::FRACTIONAL_BITS_MP_LOW_PRECISION));
+        value += static_cast<float>(buffer) * coordinates::RESOLUTION_LOW_PRECISION;
+    }
+    else
+    {
+        uint8_t buffer;
+        OK(stream.read(&buffer, coordinates::FRACTIONAL_BITS_MP));
+        value += static_cast<float>(buffer) * coordinates::RESOLUTION;
+    }
+
+    return is_negative ? -value : value;
+}
+
+inline float read_float_coordinates_multiplayer_integral(BitStream& stream)
+{
+    // Always clear value to zero; if we get no data it means zero
+    float value = 0;
+
+    uint8_t is_in_bounds;
+    OK(stream.read(&is_in_bounds, 1));
+
+    uint8_t is_non_zero;
+    OK(stream.read(&is_non_zero, 1));
+
+    if (is_non_zero)
+    {
+        uint8_t is_negative;
+        OK(stream.read(&is_negative, 1));
+
+        int16_t buffer;
+        if (is_in_bounds)
+        {
+            OK(stream.read(&buffer, coordinates::INTEGER_BITS_MP));
+        }
+        else
+        {
+            OK(stream.read(&buffer, coordinates::INTEGER_BITS));
+        }
+
+        value = static_cast<float>(buffer);
+
+        if (is_negative)
+        {
+            value = -value;
+        }
+    }
+
+    return value;
+}
+
+template<Precision P = Precision::Normal>
+inline float read_float_cell_coordinates(BitStream& stream, size_t bits)
+{
+    uint32_t buffer;
+    OK(stream.read(&buffer, bits));
+    auto value = static_cast<float>(buffer);
+
+    if constexpr (P == Precision::Low)
+    {
+        OK(stream.read(&buffer, coordinates::FRACTIONAL_BITS_MP_LOW_PRECISION));
+        value += static_cast<float>(buffer) * coordinates::RESOLUTION_LOW_PRECISION;
+    }
+    else
+    {
+        OK(stream.read(&buffer, coordinates::FRACTIONAL_BITS_MP));
+        value += static_cast<float>(buffer) * coordinates::RESOLUTION;
+    }
+
+    return value;
+}
+
+inline float read_float_cell_coordinates_integral(BitStream& stream, size_t bits)
+{
+    uint32_t buffer;
+    OK(stream.read(&buffer, bits));
+    return static_cast<float>(buffer);
+}
+
+inline float read_float_no_scale(BitStream& stream)
+{
+    // Yes, it's a float, but our read only works with integral types; just use the same size
+    uint32_t buffer;
+    OK(stream.read(&buffer, 32));
+    float value;
+    std::memcpy(&value, &buffer, sizeof(value));
+    return value;
+}
+
+inline float read_float_scaled(BitStream& stream, size_t bits, float low, float high)
+{
+    uint32_t buffer;
+    OK(stream.read(&buffer, bits));
+    return interpolate(low, high, static_cast<float>(buffer) / static_cast<float>((1 << bits) - 1));
+}
+
+/// \brief The wire encodings of a float, determined by property flags.
+enum struct FloatEncoding : uint8_t
+{
+    SCALED,
+    NO_SCALE,
+    COORDINATES,
+    NORMAL,
+    COORDINATES_MULTIPLAYER,
+    COORDINATES_MULTIPLAYER_LOW_PRECISION,
+    COORDINATES_MULTIPLAYER_INTEGRAL,
+    CELL_COORDINATES,
+    CELL_COORDINATES_LOW_PRECISION,
+    CELL_COORDINATES_INTEGRAL,
+    INVALID,
+};
+
+/// \brief Determine how a float property is encoded from its flags.
+constexpr FloatEncoding classify_float(PropertyFlags::T flags)
+{
+    using Flags = PropertyFlags;
+    if (flags & Flags::NO_SCALE && !(flags & Flags::HIGH_PRIORITY_FLOAT_FLAGS))
+    {
+        return FloatEncoding::NO_SCALE;
+    }
+
+    switch (flags & Flags::FLOAT_FLAGS)
+    {
+        case 0:
+            return FloatEncoding::SCALED;
+        case Flags::COORDINATES:
+            return FloatEncoding::COORDINATES;
+        case Flags::NORMAL:
+            return FloatEncoding::NORMAL;
+        case Flags::COORDINATES_MULTIPLAYER:
+            return FloatEncoding::COORDINATES_MULTIPLAYER;
+        case Flags::COORDINATES_MULTIPLAYER_LOW_PRECISION:
+            return FloatEncoding::COORDINATES_MULTIPLAYER_LOW_PRECISION;
+        case Flags::COORDINATES_MULTIPLAYER_INTEGRAL:
+            return FloatEncoding::COORDINATES_MULTIPLAYER_INTEGRAL;
+        case Flags::CELL_COORDINATES:
+            return FloatEncoding::CELL_COORDINATES;
+        case Flags::CELL_COORDINATES_LOW_PRECISION:
+            return FloatEncoding::CELL_COORDINATES_LOW_PRECISION;
+        case Flags::CELL_COORDINATES_INTEGRAL:
+            return FloatEncoding::CELL_COORDINATES_INTEGRAL;
+        default:
+            return FloatEncoding::INVALID;
+    }
+}
+
+/// \brief Read a float in the given encoding.
+///
+/// `bits`, `low` and `high` are only used by the scaled and cell encodings.
+inline float read_float(BitStream& stream, FloatEncoding encoding, size_t bits, float low, float high)
+{
+    switch (encoding)
+    {
+        case FloatEncoding::SCALED:
+            return read_float_scaled(stream, bits, low, high);
+        case FloatEncoding::NO_SCALE:
+            return read_float_no_scale(stream);
+        case FloatEncoding::COORDINATES:
+            return read_float_coordinates(stream);
+        case FloatEncoding::NORMAL:
+            return read_float_normal(stream);
+        case FloatEncoding::COORDINATES_MULTIPLAYER:
+            return read_float_coordinates_multiplayer(stream);
+        case FloatEncoding::COORDINATES_MULTIPLAYER_LOW_PRECISION:
+            return read_float_coordinates_multiplayer<Precision::Low>(stream);
+        case FloatEncoding::COORDINATES_MULTIPLAYER_INTEGRAL:
+            return read_float_coordinates_multiplayer_integral(stream);
+        case FloatEncoding::CELL_COORDINATES:
+            return read_float_cell_coordinates(stream, bits);
+        case FloatEncoding::CELL_COORDINATES_LOW_PRECISION:
+            return read_float_cell_coordinates<Precision::Low>(stream, bits);
+        case FloatEncoding::CELL_COORDINATES_INTEGRAL:
+            return read_float_cell_coordinates_integral(stream, bits);
+        default:
+            throw csgopp::error::GameError("invalid float encoding " + std::to_string(static_cast<int>(encoding)));
+    }
+}
+
+inline void read_string(BitStream& stream, std::string& value)
+{
+    uint32_t size;
+    stream.read(&size, string::STRING_SIZE_BITS_MAX);
+    stream.read_string_from(value, std::min(string::STRING_SIZE_MAX, size));
+}
+
+inline void read_string(BitStream& stream, InlineString& value)
+{
+    uint32_t size;
+    stream.read(&size, string::STRING_SIZE_BITS_MAX);
+    size_t length;
+    stream.read_string_from(value.data, std::min(string::STRING_SIZE_MAX, size), &length);
+    value.size = static_cast<uint16_t>(length);
+    value.data[length] = '\0';
+}
+
+}
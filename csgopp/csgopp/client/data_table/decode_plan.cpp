@@ -0,0 +1,219 @@
+#include "decode_plan.h"
+#include "data_property.h"
+#include "../../common/vector.h"
+
+#include <cmath>
+
+namespace csgopp::client::data_table::decode_plan
+{
+
+using csgopp::client::data_table::data_property::ArrayProperty;
+using csgopp::client::data_table::data_type::DataArrayType;
+using csgopp::client::data_table::data_property::FloatProperty;
+using csgopp::client::data_table::data_property::Int32Property;
+using csgopp::client::data_table::data_property::Int64Property;
+using csgopp::client::data_table::data_property::StringProperty;
+using csgopp::client::data_table::data_property::Vector2Property;
+using csgopp::client::data_table::data_property::Vector3Property;
+using csgopp::client::data_table::decode::InlineString;
+using csgopp::client::data_table::property::Property;
+using csgopp::common::vector::Vector2;
+using csgopp::common::vector::Vector3;
+using csgopp::error::GameError;
+
+template<typename T>
+static void compile_float(Instruction& instruction, const T& property)
+{
+    instruction.encoding = decode::classify_float(property.flags);
+    instruction.bits = static_cast<uint8_t>(property.bits);
+    instruction.low = property.low_value;
+    instruction.high = property.high_value;
+}
+
+static void compile(Instruction& instruction, const DataProperty& property)
+{
+    bool variable = property.flags & Property::Flags::VARIABLE_INTEGER;
+    bool is_unsigned = property.flags & Property::Flags::UNSIGNED;
+    switch (property.kind())
+    {
+        case Property::Kind::INT32:
+        {
+            const auto& int_property = static_cast<const Int32Property&>(property);
+            instruction.bits = static_cast<uint8_t>(int_property.bits);
+            if (int_property.bits == 1)
+            {
+                instruction.opcode = Opcode::BOOL;
+            }
+            else if (is_unsigned)
+            {
+                instruction.opcode = variable ? Opcode::UNSIGNED_INT32_VARIABLE : Opcode::UNSIGNED_INT32_FIXED;
+            }
+            else
+            {
+                instruction.opcode = variable ? Opcode::SIGNED_INT32_VARIABLE : Opcode::SIGNED_INT32_FIXED;
+            }
+            break;
+        }
+        case Property::Kind::INT64:
+        {
+            const auto& int_property = static_cast<const Int64Property&>(property);
+            instruction.bits = static_cast<uint8_t>(int_property.bits);
+            if (is_unsigned)
+            {
+                instruction.opcode = variable ? Opcode::UNSIGNED_INT64_VARIABLE : Opcode::UNSIGNED_INT64_FIXED;
+            }
+            else
+            {
+                instruction.opcode = variable ? Opcode::SIGNED_INT64_VARIABLE : Opcode::SIGNED_INT64_FIXED;
+            }
+            break;
+        }
+        case Property::Kind::FLOAT:
+            instruction.opcode = Opcode::FLOAT;
+            compile_float(instruction, static_cast<const FloatProperty&>(property));
+            break;
+        case Property::Kind::VECTOR3:
+            instruction.opcode = property.flags & Property::Flags::NORMAL ? Opcode::VECTOR3_NORMAL : Opcode::VECTOR3;
+            compile_float(instruction, static_cast<const Vector3Property&>(property));
+            break;
+        case Property::Kind::VECTOR2:
+            instruction.opcode = Opcode::VECTOR2;
+            compile_float(instruction, static_cast<const Vector2Property&>(property));
+            break;
+        case Property::Kind::STRING:
+            instruction.opcode = static_cast<const StringProperty&>(property).inline_layout ? Opcode::INLINE_STRING : Opcode::STRING;
+            break;
+        default:
+            throw GameError("cannot compile property " + property.name);
+    }
+}
+
+void DecodePlan::add(const DataProperty& property, size_t offset)
+{
+    Instruction& instruction = this->_instructions.emplace_back();
+    instruction.offset = static_cast<uint32_t>(offset);
+
+    if (property.kind() == Property::Kind::ARRAY)
+    {
+        const auto& array_property = static_cast<const ArrayProperty&>(property);
+        const auto& array_type = dynamic_cast<const DataArrayType&>(*array_property.type());
+        instruction.length = static_cast<uint16_t>(array_type.length);
+        instruction.length_bits = csgopp::common::bits::width(array_type.length) + 1;
+        instruction.stride = static_cast<uint32_t>(array_type.element_size);
+        compile(instruction, *array_property.element);
+    }
+    else
+    {
+        compile(instruction, property);
+    }
+}
+
+static inline void execute(const Instruction& instruction, char* address, BitStream& stream)
+{
+    switch (instruction.opcode)
+    {
+        case Opcode::BOOL:
+            *reinterpret_cast<bool*>(address) = decode::read_bool(stream);
+            break;
+        case Opcode::UNSIGNED_INT32_VARIABLE:
+            *reinterpret_cast<uint32_t*>(address) = decode::read_int_variable<uint32_t>(stream);
+            break;
+        case Opcode::UNSIGNED_INT32_FIXED:
+            *reinterpret_cast<uint32_t*>(address) = decode::read_int_fixed<uint32_t>(stream, instruction.bits);
+            break;
+        case Opcode::SIGNED_INT32_VARIABLE:
+            *reinterpret_cast<int32_t*>(address) = decode::read_int_variable<int32_t>(stream);
+            break;
+        case Opcode::SIGNED_INT32_FIXED:
+            *reinterpret_cast<int32_t*>(address) = decode::read_int32_signed(stream, instruction.bits);
+            break;
+        case Opcode::UNSIGNED_INT64_VARIABLE:
+            *reinterpret_cast<uint64_t*>(address) = decode::read_int_variable<uint64_t>(stream);
+            break;
+        case Opcode::UNSIGNED_INT64_FIXED:
+            *reinterpret_cast<uint64_t*>(address) = decode::read_int_fixed<uint64_t>(stream, instruction.bits);
+            break;
+        case Opcode::SIGNED_INT64_VARIABLE:
+            *reinterpret_cast<int64_t*>(address) = decode::read_int_variable<int64_t>(stream);
+            break;
+        case Opcode::SIGNED_INT64_FIXED:
+            *reinterpret_cast<int64_t*>(address) = decode::read_int64_signed(stream, instruction.bits);
+            break;
+        case Opcode::FLOAT:
+            *reinterpret_cast<float*>(address) = decode::read_float(
+                stream, instruction.encoding, instruction.bits, instruction.low, instruction.high);
+            break;
+        case Opcode::VECTOR2:
+        {
+            auto* value = reinterpret_cast<Vector2*>(address);
+            value->x = decode::read_float(stream, instruction.encoding, instruction.bits, instruction.low, instruction.high);
+            value->y = decode::read_float(stream, instruction.encoding, instruction.bits, instruction.low, instruction.high);
+            break;
+        }
+        case Opcode::VECTOR3:
+        {
+            auto* value = reinterpret_cast<Vector3*>(address);
+            value->x = decode::read_float(stream, instruction.encoding, instruction.bits, instruction.low, instruction.high);
+            value->y = decode::read_float(stream, instruction.encoding, instruction.bits, instruction.low, instruction.high);
+            value->z = decode::read_float(stream, instruction.encoding, instruction.bits, instruction.low, instruction.high);
+            break;
+        }
+        case Opcode::VECTOR3_NORMAL:
+        {
+            auto* value = reinterpret_cast<Vector3*>(address);
+            value->x = decode::read_float(stream, instruction.encoding, instruction.bits, instruction.low, instruction.high);
+            value->y = decode::read_float(stream, instruction.encoding, instruction.bits, instruction.low, instruction.high);
+            float magnitude = value->x * value->x + value->y * value->y;
+            value->z = magnitude < 1 ? std::sqrt(1 - magnitude) : 0;
+            if (decode::read_bool(stream))
+            {
+                value->z = -value->z;
+            }
+            break;
+        }
+        case Opcode::STRING:
+            decode::read_string(stream, *reinterpret_cast<std::string*>(address));
+            break;
+        case Opcode::INLINE_STRING:
+            decode::read_string(stream, *reinterpret_cast<InlineString*>(address));
+            break;
+    }
+}
+
+void DecodePlan::decode(char* address, BitStream& stream, uint16_t index) const
+{
+    if (index >= this->_instructions.size())
+    {
+        throw GameError("property index " + std::to_string(index) + " exceeds count " + std::to_string(this->_instructions.size()));
+    }
+
+    const Instruction& instruction = this->_instructions[index];
+    char* target = address + instruction.offset;
+    if (instruction.length_bits == 0)
+    {
+        execute(instruction, target, stream);
+        return;
+    }
+
+    size_t length;
+    OK(stream.read(&length, instruction.length_bits));
+    if (length > instruction.length)
+    {
+        throw GameError("array update of " + std::to_string(length) + " exceeds length " + std::to_string(instruction.length));
+    }
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        execute(instruction, target + i * instruction.stride, stream);
+    }
+}
+
+void DecodePlan::decode(char* address, BitStream& stream, const std::vector<uint16_t>& indices) const
+{
+    for (uint16_t index : indices)
+    {
+        this->decode(address, stream, index);
+    }
+}
+
+}
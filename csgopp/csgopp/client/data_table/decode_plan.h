@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../../common/bits.h"
+#include "decode.h"
+
+namespace csgopp::client::data_table::data_property
+{
+
+struct DataProperty;
+
+}
+
+namespace csgopp::client::data_table::decode_plan
+{
+
+using csgopp::client::data_table::data_property::DataProperty;
+using csgopp::client::data_table::decode::FloatEncoding;
+using csgopp::common::bits::BitStream;
+
+/// \brief What a single decode instruction reads.
+enum struct Opcode : uint8_t
+{
+    BOOL,
+    UNSIGNED_INT32_VARIABLE,
+    UNSIGNED_INT32_FIXED,
+    SIGNED_INT32_VARIABLE,
+    SIGNED_INT32_FIXED,
+    UNSIGNED_INT64_VARIABLE,
+    UNSIGNED_INT64_FIXED,
+    SIGNED_INT64_VARIABLE,
+    SIGNED_INT64_FIXED,
+    FLOAT,
+    VECTOR2,
+    VECTOR3,
+    /// A `Vector3` whose z is derived from x and y plus a sign bit.
+    VECTOR3_NORMAL,
+    STRING,
+    /// A string read into an `InlineString` without allocating.
+    INLINE_STRING,
+};
+
+/// \brief A flattened description of how to decode one property.
+///
+/// Arrays are encoded inline: `length_bits` is nonzero and the opcode
+/// describes each element, which is `stride` bytes after the last.
+struct Instruction
+{
+    uint32_t offset{};
+    uint32_t stride{};
+    float low{};
+    float high{};
+    uint16_t length{};
+    uint8_t length_bits{};
+    uint8_t bits{};
+    Opcode opcode{};
+    FloatEncoding encoding{};
+};
+
+/// \brief A compiled, flat program that decodes entity property updates.
+///
+/// Plans are built once per `EntityType` from its prioritized properties,
+/// so decoding an update is a single switch per changed property with no
+/// virtual calls, casts or reference counting.
+class DecodePlan
+{
+public:
+    DecodePlan() = default;
+
+    /// \brief Append the instruction for a property at an offset.
+    void add(const DataProperty& property, size_t offset);
+
+    /// \brief Decode the properties at the given prioritized indices.
+    ///
+    /// Indices come straight off the wire, so each is checked against the
+    /// instruction count and a `GameError` is thrown if it is out of range.
+    void decode(char* address, BitStream& stream, const std::vector<uint16_t>& indices) const;
+
+    /// \brief Decode a single property.
+    void decode(char* address, BitStream& stream, uint16_t index) const;
+
+    [[nodiscard]] const std::vector<Instruction>& instructions() const { return this->_instructions; }
+    [[nodiscard]] size_t size() const { return this->_instructions.size(); }
+
+private:
+    std::vector<Instruction> _instructions;
+};
+
+}
@@ -1,16 +1,161 @@
 #include "entity.h"
 #include "data_table.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace csgopp::client::entity
 {
 
 using csgopp::client::data_table::DataTable;
+using object::ArrayType;
+using object::ValueType;
+
+static void collect_strings(const Type& type, size_t offset, std::vector<size_t>& strings)
+{
+    if (const auto* object_type = dynamic_cast<const ObjectType*>(&type))
+    {
+        for (const ObjectType::Member& member : *object_type)
+        {
+            collect_strings(*member.type, offset + member.offset, strings);
+        }
+    }
+    else if (const auto* array_type = dynamic_cast<const ArrayType*>(&type))
+    {
+        for (size_t i = 0; i < array_type->length; ++i)
+        {
+            collect_strings(*array_type->element_type, offset + array_type->at(i), strings);
+        }
+    }
+    else if (const auto* value_type = dynamic_cast<const ValueType*>(&type))
+    {
+        if (value_type->info() == typeid(std::string))
+        {
+            strings.push_back(offset);
+        }
+    }
+}
+
+void EntityType::compile()
+{
+    for (const EntityDatum& datum : this->prioritized)
+    {
+        this->plan.add(*datum.property, datum.offset);
+    }
+
+    collect_strings(*this, 0, this->strings);
+    std::sort(this->strings.begin(), this->strings.end());
+}
+
+void EntityType::copy(const char* source, char* destination) const
+{
+    size_t cursor = 0;
+    for (size_t offset : this->strings)
+    {
+        std::memcpy(destination + cursor, source + cursor, offset - cursor);
+        *reinterpret_cast<std::string*>(destination + offset) = *reinterpret_cast<const std::string*>(source + offset);
+        cursor = offset + sizeof(std::string);
+    }
+    std::memcpy(destination + cursor, source + cursor, this->size() - cursor);
+}
 
 Entity::Entity(std::shared_ptr<const EntityType>&& type, Id id, std::shared_ptr<const ServerClass> server_class)
     : Instance<EntityType>(std::move(type))
     , id(id)
     , server_class(std::move(server_class))
+    , dirty(this->type->prioritized.size())
+{
+}
+
+EntityMask::EntityMask(size_t size)
+    : _words((size + 63) / 64)
+    , _size(size)
+{
+}
+
+EntityMask EntityMask::of(const EntityType& type, const Lens& lens)
+{
+    EntityMask mask(type.prioritized.size());
+    size_t begin = lens.offset;
+    size_t end = lens.offset + lens.type->size();
+    for (size_t i = 0; i < type.prioritized.size(); ++i)
+    {
+        const EntityDatum& datum = type.prioritized[i];
+        if (datum.offset < end && begin < datum.offset + datum.type->size())
+        {
+            mask.set(i);
+        }
+    }
+    return mask;
+}
+
+EntityMask EntityMask::of(const EntityType& type, const std::vector<std::string>& names)
+{
+    EntityMask mask(type.prioritized.size());
+    for (const std::string& name : names)
+    {
+        bool found = false;
+        for (size_t i = 0; i < type.prioritized.size(); ++i)
+        {
+            if (type.prioritized[i].qualified_name() == name)
+            {
+                mask.set(i);
+                found = true;
+                break;
+            }
+        }
+
+        if (!found)
+        {
+            throw csgopp::error::GameError("entity type has no property " + name);
+        }
+    }
+    return mask;
+}
+
+void EntityMask::fill()
+{
+    std::fill(this->_words.begin(), this->_words.end(), ~uint64_t(0));
+    if (this->_size % 64 != 0)
+    {
+        this->_words.back() = (uint64_t(1) << (this->_size % 64)) - 1;
+    }
+}
+
+void EntityMask::reset()
+{
+    std::fill(this->_words.begin(), this->_words.end(), 0);
+}
+
+bool EntityMask::any() const
+{
+    return std::any_of(this->_words.begin(), this->_words.end(), [](uint64_t word)
+    {
+        return word != 0;
+    });
+}
+
+bool EntityMask::intersects(const EntityMask& other) const
+{
+    size_t count = std::min(this->_words.size(), other._words.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (this->_words[i] & other._words[i])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+EntityMask& EntityMask::operator|=(const EntityMask& other)
 {
+    size_t count = std::min(this->_words.size(), other._words.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+        this->_words[i] |= other._words[i];
+    }
+    return *this;
 }
 
 }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <absl/container/flat_hash_map.h>
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
@@ -12,6 +14,7 @@
 #include "data_table.h"
 #include "data_table/data_property.h"
 #include "data_table/data_table_property.h"
+#include "data_table/decode_plan.h"
 #include <object/code.h>
 #include <object/object.h>
 
@@ -22,12 +25,14 @@ using csgopp::client::data_table::data_property::DataProperty;
 using csgopp::client::data_table::data_table_property::DataTableProperty;
 using csgopp::client::data_table::data_type::DataType;
 using csgopp::client::data_table::DataTable;
+using csgopp::client::data_table::decode_plan::DecodePlan;
 using csgopp::client::data_table::property::Property;
 using csgopp::client::server_class::ServerClass;
 using csgopp::common::database::Database;
 using object::Accessor;
 using object::ConstReference;
 using object::Instance;
+using object::Lens;
 using object::ObjectType;
 using object::Type;
 
@@ -113,7 +118,72 @@ struct EntityType final : public ObjectType
     /// Flattened, reordered members used for updates
     std::vector<EntityDatum> prioritized;
 
+    /// Compiled from `prioritized`, indexed the same way
+    DecodePlan plan;
+
+    /// Sorted offsets of every `std::string`, which can't be copied bytewise
+    std::vector<size_t> strings;
+
     using ObjectType::ObjectType;
+
+    /// \brief Build `plan` and `strings` once `prioritized` is final.
+    void compile();
+
+    /// \brief Copy one constructed instance of this type over another.
+    ///
+    /// Everything between strings is copied with `memcpy`, so this is much
+    /// cheaper than assigning member by member.
+    void copy(const char* source, char* destination) const;
+
+    /// \brief Whether instances can be copied with a single `memcpy`.
+    ///
+    /// True when there are no `std::string` members, e.g. when strings use
+    /// the inline layout from `Client::set_inline_strings`.
+    [[nodiscard]] bool trivially_copyable() const { return this->strings.empty(); }
+};
+
+/// \brief A decoded instance baseline, copied into new entities.
+using Baseline = Instance<EntityType>;
+
+/// \brief A set of indices into `EntityType::prioritized`.
+///
+/// Build a mask once from an accessor or property names, then test it
+/// against an entity's `dirty` set a word at a time instead of comparing
+/// every changed property against the accessor.
+class EntityMask
+{
+public:
+    EntityMask() = default;
+    explicit EntityMask(size_t size);
+
+    /// \brief Every property of the type that overlaps a lens.
+    ///
+    /// \param lens typically an `Accessor` into the entity type.
+    static EntityMask of(const EntityType& type, const Lens& lens);
+
+    /// \brief The properties of the type with the given qualified names.
+    ///
+    /// \throws GameError if the type has no property by one of the names.
+    static EntityMask of(const EntityType& type, const std::vector<std::string>& names);
+
+    void set(size_t index) { this->_words[index / 64] |= uint64_t(1) << (index % 64); }
+    [[nodiscard]] bool test(size_t index) const { return this->_words[index / 64] >> (index % 64) & 1; }
+
+    /// \brief Set every index.
+    void fill();
+
+    /// \brief Clear every index.
+    void reset();
+
+    [[nodiscard]] bool any() const;
+    [[nodiscard]] bool intersects(const EntityMask& other) const;
+    [[nodiscard]] size_t size() const { return this->_size; }
+
+    EntityMask& operator|=(const EntityMask& other);
+
+private:
+    std::vector<uint64_t> _words;
+    size_t _size{0};
 };
 
 struct EntityConstReference : public ConstReference
@@ -143,8 +213,18 @@ struct Entity final : public Instance<EntityType>
     Id id;
     std::shared_ptr<const ServerClass> server_class;
 
+    /// Properties changed during `dirty_tick`; a new entity is all dirty
+    EntityMask dirty;
+    uint32_t dirty_tick{};
+
     Entity(std::shared_ptr<const EntityType>&& type, Id id, std::shared_ptr<const ServerClass> server_class);
 
+    /// \brief Whether any property in the mask changed during a tick.
+    [[nodiscard]] bool changed(const EntityMask& mask, uint32_t tick) const
+    {
+        return this->dirty_tick == tick && this->dirty.intersects(mask);
+    }
+
     // TODO: naming?
     [[nodiscard]] EntityConstReference at(size_t prioritized_index) const
     {
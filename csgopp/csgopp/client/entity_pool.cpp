@@ -0,0 +1,120 @@
+#include "entity_pool.h"
+
+namespace csgopp::client::entity_pool
+{
+
+double Statistics::hit_rate() const
+{
+    uint64_t total = this->hits + this->misses;
+    return total > 0 ? static_cast<double>(this->hits) / static_cast<double>(total) : 0;
+}
+
+EntityPool::EntityPool(size_t limit) : _limit(limit)
+{
+}
+
+std::shared_ptr<Entity> EntityPool::acquire(
+    std::shared_ptr<const EntityType> type,
+    Entity::Id id,
+    std::shared_ptr<const ServerClass> server_class,
+    const Baseline* baseline
+)
+{
+    std::unique_ptr<Entity> entity;
+    {
+        std::lock_guard lock(this->_mutex);
+        auto iterator = this->_free.find(type.get());
+        if (iterator != this->_free.end() && !iterator->second.entities.empty())
+        {
+            FreeList& free = iterator->second;
+            entity = std::move(free.entities.back());
+            free.entities.pop_back();
+            this->_statistics.hits += 1;
+            this->_statistics.retained -= 1;
+            this->_statistics.bytes_retained -= type->size();
+
+            // Only this thread mutates pristine instances, so the pointer stays valid after unlocking
+            if (baseline == nullptr)
+            {
+                if (free.pristine == nullptr)
+                {
+                    free.pristine = std::make_unique<Baseline>(type);
+                }
+                baseline = free.pristine.get();
+            }
+        }
+        else
+        {
+            this->_statistics.misses += 1;
+        }
+    }
+
+    if (entity != nullptr)
+    {
+        entity->id = id;
+        entity->server_class = std::move(server_class);
+    }
+    else
+    {
+        entity = std::make_unique<Entity>(std::move(type), id, std::move(server_class));
+    }
+
+    if (baseline != nullptr)
+    {
+        entity->type->copy(baseline->address.get(), entity->address.get());
+    }
+
+    return std::shared_ptr<Entity>(entity.release(), [pool = this->shared_from_this()](Entity* released)
+    {
+        pool->release(released);
+    });
+}
+
+void EntityPool::release(Entity* entity)
+{
+    std::unique_ptr<Entity> owned(entity);
+    size_t size = entity->type->size();
+
+    std::lock_guard lock(this->_mutex);
+    if (this->_statistics.bytes_retained + size > this->_limit)
+    {
+        this->_statistics.discarded += 1;
+        return;
+    }
+
+    this->_free[entity->type.get()].entities.emplace_back(std::move(owned));
+    this->_statistics.recycled += 1;
+    this->_statistics.retained += 1;
+    this->_statistics.bytes_retained += size;
+}
+
+void EntityPool::clear()
+{
+    absl::flat_hash_map<const EntityType*, FreeList> free;
+    {
+        std::lock_guard lock(this->_mutex);
+        std::swap(free, this->_free);
+        this->_statistics.retained = 0;
+        this->_statistics.bytes_retained = 0;
+    }
+}
+
+void EntityPool::set_limit(size_t limit)
+{
+    std::lock_guard lock(this->_mutex);
+    this->_limit = limit;
+}
+
+size_t EntityPool::limit() const
+{
+    std::lock_guard lock(this->_mutex);
+    return this->_limit;
+}
+
+Statistics EntityPool::statistics() const
+{
+    std::lock_guard lock(this->_mutex);
+    return this->_statistics;
+}
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "entity.h"
+
+/// Recycling entity storage across creations of the same class.
+///
+/// Weapons, projectiles and effects are created and deleted constantly, and
+/// each one used to cost two heap allocations plus a recursive construction
+/// of its type. The pool keeps released entities in a free list per
+/// `EntityType` and resets them from a baseline when they are reused.
+namespace csgopp::client::entity_pool
+{
+
+using csgopp::client::entity::Baseline;
+using csgopp::client::entity::Entity;
+using csgopp::client::entity::EntityType;
+using csgopp::client::server_class::ServerClass;
+
+struct Statistics
+{
+    /// Entities reused from a free list.
+    uint64_t hits{};
+    /// Entities that had to be allocated and constructed.
+    uint64_t misses{};
+    /// Released entities kept for reuse.
+    uint64_t recycled{};
+    /// Released entities freed because the pool was at its limit.
+    uint64_t discarded{};
+    /// Entities currently waiting in free lists.
+    size_t retained{};
+    /// Instance bytes held by retained entities.
+    size_t bytes_retained{};
+
+    /// \brief The fraction of acquisitions served from a free list.
+    [[nodiscard]] double hit_rate() const;
+};
+
+/// \brief Free lists of entities, one per `EntityType`.
+///
+/// Entities are handed out as `std::shared_ptr` whose deleter returns them
+/// to the pool, so observers may keep an entity past its deletion and it
+/// is only recycled once the last reference is gone. Entities may be
+/// released from any thread, but `acquire` and `clear` belong to the
+/// thread that owns the client.
+class EntityPool : public std::enable_shared_from_this<EntityPool>
+{
+public:
+    /// The default bound on instance bytes kept in free lists.
+    static constexpr size_t DEFAULT_LIMIT = 64 * 1024 * 1024;
+
+    explicit EntityPool(size_t limit = DEFAULT_LIMIT);
+
+    /// \brief Get an entity initialized from a baseline.
+    ///
+    /// \param baseline the state to start from, or null to start from a
+    ///     default constructed instance of the type.
+    std::shared_ptr<Entity> acquire(
+        std::shared_ptr<const EntityType> type,
+        Entity::Id id,
+        std::shared_ptr<const ServerClass> server_class,
+        const Baseline* baseline);
+
+    /// \brief Free every retained entity, e.g. when the schema changes.
+    void clear();
+
+    /// \brief Bound the instance bytes retained; zero disables recycling.
+    void set_limit(size_t limit);
+    [[nodiscard]] size_t limit() const;
+
+    [[nodiscard]] Statistics statistics() const;
+
+private:
+    struct FreeList
+    {
+        std::vector<std::unique_ptr<Entity>> entities;
+        /// Default constructed, for resetting entities without a baseline.
+        std::unique_ptr<Baseline> pristine;
+    };
+
+    void release(Entity* entity);
+
+    mutable std::mutex _mutex;
+    absl::flat_hash_map<const EntityType*, FreeList> _free;
+    size_t _limit;
+    Statistics _statistics;
+};
+
+}
@@ -0,0 +1,140 @@
+#include "history.h"
+
+#include <algorithm>
+#include <string>
+
+namespace csgopp::client::history
+{
+
+History::History(std::shared_ptr<EntityPool> pool, uint32_t start, uint32_t ticks, size_t budget)
+    : _pool(std::move(pool))
+    , _ticks(ticks)
+    , _budget(budget)
+    , _horizon(start)
+    , _frames(ticks)
+{
+    if (ticks == 0)
+    {
+        throw HistoryError("history must cover at least one tick");
+    }
+}
+
+void History::before_update(uint32_t tick, const Entity& entity)
+{
+    if (Frame* frame = this->_frame(tick, entity.id))
+    {
+        std::shared_ptr<Entity> copy = this->_pool->acquire(entity.type, entity.id, entity.server_class, &entity);
+        this->_save(*frame, entity.id, std::move(copy));
+    }
+}
+
+void History::before_replace(uint32_t tick, Entity::Id id, std::shared_ptr<const Entity> previous)
+{
+    if (Frame* frame = this->_frame(tick, id))
+    {
+        this->_save(*frame, id, std::move(previous));
+    }
+}
+
+std::optional<std::shared_ptr<const Entity>> History::find(Entity::Id id, uint32_t tick) const
+{
+    if (!this->covers(tick))
+    {
+        throw HistoryError(
+            "tick " + std::to_string(tick) + " is before the history, which starts at " + std::to_string(this->_horizon));
+    }
+
+    // The first change after the tick saved the state as of its end
+    size_t low = 0;
+    size_t high = this->_frames.size();
+    while (low < high)
+    {
+        size_t middle = (low + high) / 2;
+        if (this->_frames.at(middle).tick <= tick)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    for (size_t i = low; i < this->_frames.size(); ++i)
+    {
+        for (const Change& change : this->_frames.at(i).changes)
+        {
+            if (change.id == id)
+            {
+                return change.before;
+            }
+        }
+    }
+
+    return std::nullopt;
+}
+
+void History::clear(uint32_t tick)
+{
+    while (this->_frames.size() > 0)
+    {
+        this->_evict();
+    }
+    this->_horizon = tick;
+}
+
+Frame* History::_frame(uint32_t tick, Entity::Id id)
+{
+    if (this->_frames.size() == 0 || this->_frames.at(this->_frames.size() - 1).tick != tick)
+    {
+        while (
+            this->_frames.size() > 0
+            && (this->_frames.size() >= this->_ticks || this->_frames.at(0).tick + this->_ticks <= tick)
+        )
+        {
+            this->_evict();
+        }
+
+        // Assigning an empty frame keeps the slot's change capacity
+        this->_frames.push_back(Frame{tick, {}, 0});
+        this->_serial += 1;
+    }
+
+    if (id >= this->_saved.size())
+    {
+        this->_saved.resize(id + 1, 0);
+    }
+    if (this->_saved[id] == this->_serial)
+    {
+        return nullptr;
+    }
+
+    this->_saved[id] = this->_serial;
+    return &this->_frames.at(this->_frames.size() - 1);
+}
+
+void History::_save(Frame& frame, Entity::Id id, std::shared_ptr<const Entity> before)
+{
+    size_t bytes = before != nullptr ? before->type->size() : 0;
+    frame.changes.push_back(Change{id, std::move(before)});
+    frame.bytes += bytes;
+    this->_bytes += bytes;
+
+    // Always keep the current tick, even if it alone is over budget
+    while (this->_bytes > this->_budget && this->_frames.size() > 1)
+    {
+        this->_evict();
+    }
+}
+
+void History::_evict()
+{
+    Frame& oldest = this->_frames.at(0);
+    this->_horizon = std::max(this->_horizon, oldest.tick);
+    this->_bytes -= oldest.bytes;
+    oldest.changes.clear();
+    oldest.bytes = 0;
+    this->_frames.pop_front();
+}
+
+}
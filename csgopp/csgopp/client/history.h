@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "../common/ring.h"
+#include "../error.h"
+#include "entity.h"
+#include "entity_pool.h"
+
+/// A rolling history of entity states over the last few ticks.
+///
+/// Rather than snapshotting the whole world every tick, the history keeps an
+/// undo log: the first time an entity slot changes in a tick, its previous
+/// state is saved. Updated entities are copied once per tick they change in,
+/// while created, replaced and deleted entities just keep a reference to the
+/// old entity, so ticks where nothing happens to an entity cost nothing.
+namespace csgopp::client::history
+{
+
+using csgopp::client::entity::Entity;
+using csgopp::client::entity_pool::EntityPool;
+using csgopp::common::ring::Ring;
+
+class HistoryError : public csgopp::error::Error
+{
+    using Error::Error;
+};
+
+/// \brief The state of an entity slot before it first changed in a tick.
+struct Change
+{
+    Entity::Id id;
+    /// Null if the slot was empty.
+    std::shared_ptr<const Entity> before;
+};
+
+/// \brief Every change made in a single tick.
+struct Frame
+{
+    uint32_t tick{};
+    std::vector<Change> changes;
+    /// The bytes of entity state kept alive by `changes`.
+    size_t bytes{};
+};
+
+class History
+{
+public:
+    /// The default bound on bytes of entity state kept by the history.
+    static constexpr size_t DEFAULT_BUDGET = 256 * 1024 * 1024;
+
+    /// \brief Keep entity states for the given number of ticks.
+    ///
+    /// \param pool where copies of updated entities are taken from, so
+    ///     evicted copies are recycled.
+    /// \param start the current tick, before which nothing is known.
+    /// \param ticks how far back states can be looked up, at least one.
+    /// \param budget the bytes of entity state to keep at most; the oldest
+    ///     ticks are dropped early to stay within it.
+    History(std::shared_ptr<EntityPool> pool, uint32_t start, uint32_t ticks, size_t budget = DEFAULT_BUDGET);
+
+    /// \brief Save an entity before it is updated in place.
+    void before_update(uint32_t tick, const Entity& entity);
+
+    /// \brief Save the entity in a slot before it is replaced or deleted.
+    ///
+    /// \param previous the entity leaving the slot, or null if it was empty.
+    void before_replace(uint32_t tick, Entity::Id id, std::shared_ptr<const Entity> previous);
+
+    /// \brief Find the state of an entity slot as of the end of a tick.
+    ///
+    /// \return the saved state, which is null if the slot was empty, or
+    ///     nothing if the slot hasn't changed since and its current entity
+    ///     is the answer.
+    /// \throws HistoryError if the tick is older than the history covers.
+    [[nodiscard]] std::optional<std::shared_ptr<const Entity>> find(Entity::Id id, uint32_t tick) const;
+
+    /// \brief Whether states as of the end of `tick` can be found.
+    [[nodiscard]] bool covers(uint32_t tick) const { return tick >= this->_horizon; }
+
+    /// \brief Forget every saved state, e.g. when the schema changes.
+    ///
+    /// \param tick the tick from which states are known again.
+    void clear(uint32_t tick);
+
+    [[nodiscard]] uint32_t ticks() const { return this->_ticks; }
+    [[nodiscard]] size_t budget() const { return this->_budget; }
+    [[nodiscard]] size_t bytes() const { return this->_bytes; }
+    [[nodiscard]] size_t size() const { return this->_frames.size(); }
+
+private:
+    /// \brief Get the frame for a tick, starting a new one if needed.
+    ///
+    /// \return null if the slot was already saved this tick.
+    Frame* _frame(uint32_t tick, Entity::Id id);
+    void _save(Frame& frame, Entity::Id id, std::shared_ptr<const Entity> before);
+    void _evict();
+
+    std::shared_ptr<EntityPool> _pool;
+    uint32_t _ticks;
+    size_t _budget;
+    size_t _bytes{0};
+    /// States as of any tick before this have been dropped.
+    uint32_t _horizon{0};
+    Ring<Frame> _frames;
+    /// Per slot, the serial of the last frame that saved it, counting from one
+    std::vector<uint64_t> _saved;
+    uint64_t _serial{0};
+};
+
+}
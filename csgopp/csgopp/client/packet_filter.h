@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+
+#include "netmessages.pb.h"
+
+namespace csgopp::client::packet_filter
+{
+
+using csgo::message::net::NET_Messages;
+using csgo::message::net::SVC_Messages;
+
+/// \brief A set of net message types that the client should dispatch.
+///
+/// Messages excluded by the filter are skipped by their length prefix
+/// without being parsed or passed to any hook. Types beyond the filter's
+/// capacity are always dispatched so unknown messages still reach
+/// `advance_packet_unknown`.
+class PacketFilter
+{
+public:
+    static constexpr uint32_t CAPACITY = 128;
+
+    constexpr PacketFilter() = default;
+
+    constexpr PacketFilter(std::initializer_list<uint32_t> types)
+    {
+        for (uint32_t type : types)
+        {
+            this->enable(type);
+        }
+    }
+
+    /// \brief A filter that dispatches every message, the default.
+    static constexpr PacketFilter all()
+    {
+        PacketFilter filter;
+        filter._words[0] = ~uint64_t(0);
+        filter._words[1] = ~uint64_t(0);
+        return filter;
+    }
+
+    /// \brief The messages the client needs to keep its state consistent.
+    ///
+    /// These are always dispatched regardless of the filter a client is
+    /// given, since skipping them would corrupt the schema, string tables,
+    /// users, game event types or entities. Events-only clients drop
+    /// `svc_PacketEntities` since they keep no entity state.
+    static constexpr PacketFilter required()
+    {
+        return {
+            SVC_Messages::svc_SendTable,
+            SVC_Messages::svc_CreateStringTable,
+            SVC_Messages::svc_UpdateStringTable,
+            SVC_Messages::svc_GameEventList,
+            SVC_Messages::svc_PacketEntities,
+        };
+    }
+
+    constexpr PacketFilter& enable(uint32_t type)
+    {
+        if (type < CAPACITY)
+        {
+            this->_words[type >> 6] |= uint64_t(1) << (type & 63);
+        }
+        return *this;
+    }
+
+    constexpr PacketFilter& disable(uint32_t type)
+    {
+        if (type < CAPACITY)
+        {
+            this->_words[type >> 6] &= ~(uint64_t(1) << (type & 63));
+        }
+        return *this;
+    }
+
+    [[nodiscard]] constexpr bool test(uint32_t type) const
+    {
+        return type >= CAPACITY || (this->_words[type >> 6] >> (type & 63)) & 1;
+    }
+
+    constexpr PacketFilter operator|(const PacketFilter& other) const
+    {
+        PacketFilter filter;
+        filter._words[0] = this->_words[0] | other._words[0];
+        filter._words[1] = this->_words[1] | other._words[1];
+        return filter;
+    }
+
+    constexpr PacketFilter operator&(const PacketFilter& other) const
+    {
+        PacketFilter filter;
+        filter._words[0] = this->_words[0] & other._words[0];
+        filter._words[1] = this->_words[1] & other._words[1];
+        return filter;
+    }
+
+    constexpr bool operator==(const PacketFilter& other) const = default;
+
+private:
+    uint64_t _words[2]{};
+};
+
+}
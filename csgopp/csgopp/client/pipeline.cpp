@@ -0,0 +1,221 @@
+#include "pipeline.h"
+#include "../common/macro.h"
+
+namespace csgopp::client::pipeline
+{
+
+using google::protobuf::io::CodedOutputStream;
+
+using csgopp::demo::FrameHeader;
+
+static void append_varint(std::string& data, uint32_t value)
+{
+    uint8_t buffer[5];  // The longest varint32
+    uint8_t* end = CodedOutputStream::WriteVarint32ToArray(value, buffer);
+    data.append(reinterpret_cast<const char*>(buffer), end - buffer);
+}
+
+template<typename T>
+static void append_little_endian(std::string& data, T value)
+{
+    data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void append_raw(CodedInputStream& stream, std::string& data, uint32_t size)
+{
+    size_t start = data.size();
+    data.resize(start + size);
+    OK(stream.ReadRaw(data.data() + start, static_cast<int>(size)));
+}
+
+static void read_messages(CodedInputStream& stream, Frame& frame, uint32_t size, const PacketFilter& filter)
+{
+    CodedInputStream::Limit limit = stream.PushLimit(static_cast<int>(size));
+
+    while (stream.BytesUntilLimit() > 0)
+    {
+        uint32_t command = stream.ReadTag();
+        uint32_t length;
+        OK(stream.ReadVarint32(&length));
+
+        // The client would skip these anyway, so don't parse or copy them
+        if (!filter.test(command))
+        {
+            OK(stream.Skip(static_cast<int>(length)));
+            continue;
+        }
+
+        Message& message = frame.messages.emplace_back();
+        message.command = command;
+        if (command == csgo::message::net::SVC_Messages::svc_PacketEntities)
+        {
+            CodedInputStream::Limit inner = stream.PushLimit(static_cast<int>(length));
+            message.entities = std::make_unique<CSVCMsg_PacketEntities>();
+            OK(message.entities->ParseFromCodedStream(&stream));
+            OK(stream.BytesUntilLimit() == 0);
+            stream.PopLimit(inner);
+        }
+        else
+        {
+            // Re-encoded so the client can run its usual handler over it
+            append_varint(message.data, command);
+            append_varint(message.data, length);
+            append_raw(stream, message.data, length);
+        }
+    }
+
+    OK(stream.BytesUntilLimit() == 0);
+    stream.PopLimit(limit);
+}
+
+bool read(CodedInputStream& stream, Frame& frame, const PacketFilter& filter)
+{
+    frame.data.clear();
+    frame.messages.clear();
+
+    FrameHeader header;
+    if (!header.deserialize(stream))
+    {
+        return false;
+    }
+
+    frame.command = header.command;
+    frame.tick = header.tick;
+    switch (frame.command)
+    {
+        case Command::SIGN_ON:
+        case Command::PACKET:
+            read_messages(stream, frame, header.size, filter);
+            break;
+        case Command::USER_COMMAND:
+            append_little_endian(frame.data, header.sequence);
+            append_little_endian(frame.data, header.size);
+            append_raw(stream, frame.data, header.size);
+            break;
+        case Command::CONSOLE_COMMAND:
+        case Command::DATA_TABLES:
+        case Command::STRING_TABLES:
+            append_little_endian(frame.data, header.size);
+            append_raw(stream, frame.data, header.size);
+            break;
+        default:
+            break;
+    }
+
+    frame.end = stream.CurrentPosition();
+    return true;
+}
+
+bool continues(Command::Type command)
+{
+    return command != Command::STOP && FrameHeader::sized(command);
+}
+
+Pipeline::Pipeline(CodedInputStream& stream, const PacketFilter& filter, size_t depth)
+    : _stream(stream)
+    , _filter(filter)
+    , _full(depth + 1)  // Room for every frame plus the end marker
+    , _free(depth)
+{
+    OK(depth > 0);
+
+    for (size_t i = 0; i < depth; ++i)
+    {
+        OK(this->_free.try_push(std::make_unique<Frame>()));
+    }
+
+    this->_thread = std::thread(&Pipeline::produce, this);
+}
+
+Pipeline::~Pipeline()
+{
+    this->_stopping.store(true, std::memory_order_release);
+
+    // Wake the reader if it's waiting on a free frame
+    this->_free.produced.fetch_add(1, std::memory_order_release);
+    this->_free.produced.notify_one();
+    this->_thread.join();
+}
+
+void Pipeline::produce()
+{
+    try
+    {
+        while (!this->_stopping.load(std::memory_order_acquire))
+        {
+            std::unique_ptr<Frame> frame;
+            while (!this->_free.try_pop(frame))
+            {
+                uint32_t seen = this->_free.produced.load(std::memory_order_acquire);
+                if (this->_stopping.load(std::memory_order_acquire))
+                {
+                    return;
+                }
+                if (this->_free.try_pop(frame))
+                {
+                    break;
+                }
+                this->_free.produced.wait(seen, std::memory_order_acquire);
+            }
+
+            if (!read(this->_stream, *frame, this->_filter))
+            {
+                throw PipelineError("demo ended without a STOP frame");
+            }
+
+            bool last = !continues(frame->command);
+            OK(this->_full.try_push(std::move(frame)));
+            if (last)
+            {
+                break;
+            }
+        }
+    }
+    catch (...)
+    {
+        this->_error = std::current_exception();
+    }
+
+    // A null frame marks the end of input, published after any error
+    OK(this->_full.try_push(nullptr));
+}
+
+Frame* Pipeline::next()
+{
+    if (this->_current != nullptr)
+    {
+        OK(this->_free.try_push(std::move(this->_current)));
+    }
+
+    if (this->_finished)
+    {
+        return nullptr;
+    }
+
+    if (!this->_full.try_pop(this->_current))
+    {
+        while (true)
+        {
+            uint32_t seen = this->_full.produced.load(std::memory_order_acquire);
+            if (this->_full.try_pop(this->_current))
+            {
+                break;
+            }
+            this->_full.produced.wait(seen, std::memory_order_acquire);
+        }
+        this->_stalls += 1;
+    }
+
+    if (this->_current == nullptr)
+    {
+        this->_finished = true;
+        if (this->_error)
+        {
+            std::rethrow_exception(this->_error);
+        }
+    }
+
+    return this->_current.get();
+}
+
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <google/protobuf/io/coded_stream.h>
+
+#include "../common/queue.h"
+#include "../demo.h"
+#include "../error.h"
+#include "packet_filter.h"
+#include "netmessages.pb.h"
+
+/// Splitting and pre-parsing frames ahead of the client.
+///
+/// `Client::advance` reads a frame, parses its net messages and applies
+/// them to state one after another. A `Pipeline` moves the first two steps
+/// to a reader thread: it splits frames and net messages out of the demo,
+/// skips messages the client's `PacketFilter` excludes and parses
+/// `svc_PacketEntities`, the bulk of most demos, so the client's thread
+/// only decodes entity data and runs hooks. Frames are applied with
+/// `Client::advance(Frame&)` in demo order, so hooks and ticks are exactly
+/// as they are without the pipeline.
+namespace csgopp::client::pipeline
+{
+
+using csgo::message::net::CSVCMsg_PacketEntities;
+using csgopp::common::queue::Queue;
+using csgopp::client::packet_filter::PacketFilter;
+using csgopp::demo::Command;
+using google::protobuf::io::CodedInputStream;
+
+class PipelineError : public csgopp::error::Error
+{
+    using Error::Error;
+};
+
+/// \brief A net message split out of a packet frame.
+struct Message
+{
+    uint32_t command{};
+    /// The serialized message, tag and length included, unless parsed
+    std::string data;
+    /// Parsed on the reader thread for `svc_PacketEntities`, else null
+    std::unique_ptr<CSVCMsg_PacketEntities> entities;
+};
+
+/// \brief A frame read ahead of the client.
+struct Frame
+{
+    Command::Type command{};
+    uint32_t tick{};
+    /// The payload following the player slot, for frames other than packets
+    std::string data;
+    /// The net messages of `SIGN_ON` and `PACKET` frames
+    std::vector<Message> messages;
+    /// The stream position after the frame, used for checkpoints
+    int64_t end{};
+};
+
+/// \brief Read the next frame of a demo.
+///
+/// Net messages the filter excludes are skipped without being parsed or
+/// copied into the frame.
+///
+/// \return false at a clean end of input.
+/// \throws GameError if the frame is truncated or malformed.
+bool read(CodedInputStream& stream, Frame& frame, const PacketFilter& filter = PacketFilter::all());
+
+/// \brief Whether frames can still follow one with the given command.
+///
+/// Frames end at `STOP`, and `CUSTOM_DATA` or unknown frames can't be
+/// skipped because their size is unknown.
+bool continues(Command::Type command);
+
+/// \brief Reads frames on a dedicated thread.
+///
+/// Up to `depth` frames are kept read ahead of the client. Frames cycle
+/// between the threads through a pair of single-producer single-consumer
+/// queues, so their buffers are reused. The stream belongs to the reader
+/// thread until the pipeline is destroyed. The filter is copied, so later
+/// changes to the client's filter don't reach frames already being read.
+/// Errors raised while reading are rethrown on the client's thread once it
+/// reaches them.
+class Pipeline
+{
+public:
+    static constexpr size_t DEFAULT_DEPTH = 64;
+
+    Pipeline(CodedInputStream& stream, const PacketFilter& filter, size_t depth = DEFAULT_DEPTH);
+    ~Pipeline();
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    /// \brief Get the next frame, waiting for the reader if needed.
+    ///
+    /// The frame is valid until the next call.
+    ///
+    /// \return null once the last frame has been returned.
+    Frame* next();
+
+    /// Times the client found no frame ready and had to wait.
+    [[nodiscard]] uint64_t stalls() const { return this->_stalls; }
+
+private:
+    void produce();
+
+    CodedInputStream& _stream;
+    const PacketFilter _filter;
+    Queue<std::unique_ptr<Frame>> _full;
+    Queue<std::unique_ptr<Frame>> _free;
+    std::atomic<bool> _stopping{false};
+    std::exception_ptr _error;
+    std::thread _thread;
+
+    // Client side only
+    std::unique_ptr<Frame> _current;
+    bool _finished{false};
+    uint64_t _stalls{0};
+};
+
+}
@@ -0,0 +1,240 @@
+#include "schema_cache.h"
+#include "checkpoint.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+namespace csgopp::client::schema_cache
+{
+
+using csgopp::client::checkpoint::Reader;
+using csgopp::client::checkpoint::Writer;
+
+SchemaCache::SchemaCache(std::filesystem::path directory)
+    : _directory(std::move(directory))
+{
+    std::error_code error;
+    std::filesystem::create_directories(*this->_directory, error);
+    if (error)
+    {
+        throw SchemaCacheError("failed to create schema cache directory " + this->_directory->string());
+    }
+}
+
+const std::shared_ptr<SchemaCache>& SchemaCache::shared()
+{
+    static const std::shared_ptr<SchemaCache> cache = std::make_shared<SchemaCache>();
+    return cache;
+}
+
+std::shared_ptr<const Schema> SchemaCache::find(const Key& key) const
+{
+    for (const std::shared_ptr<const Schema>& schema : this->_schemas)
+    {
+        if (schema->hash == key.first && schema->inline_strings == key.second)
+        {
+            return schema;
+        }
+    }
+
+    return nullptr;
+}
+
+std::shared_ptr<const Schema> SchemaCache::get(uint64_t hash, bool inline_strings, const Build& build)
+{
+    Key key(hash, inline_strings);
+    {
+        std::unique_lock lock(this->_mutex);
+        while (true)
+        {
+            if (std::shared_ptr<const Schema> schema = this->find(key))
+            {
+                this->_statistics.hits += 1;
+                return schema;
+            }
+            if (std::find(this->_building.begin(), this->_building.end(), key) == this->_building.end())
+            {
+                break;
+            }
+            this->_built.wait(lock);
+        }
+        this->_building.push_back(key);
+    }
+
+    // Built outside the lock so unrelated schemas don't wait on each other
+    auto schema = std::make_shared<Schema>();
+    schema->hash = hash;
+    schema->inline_strings = inline_strings;
+    bool complete{false};
+    try
+    {
+        schema->orders = this->load_orders(hash);
+        build(*schema, schema->orders.has_value() ? &schema->orders.value() : nullptr);
+
+        // Checked before sharing, after which types may be constructed concurrently
+        complete = std::all_of(
+            schema->server_classes.begin(),
+            schema->server_classes.end(),
+            [](const std::shared_ptr<ServerClass>& server_class) { return server_class->type() != nullptr; }
+        );
+    }
+    catch (...)
+    {
+        {
+            std::lock_guard lock(this->_mutex);
+            std::erase(this->_building, key);
+        }
+        this->_built.notify_all();
+        throw;
+    }
+
+    {
+        std::lock_guard lock(this->_mutex);
+        this->_schemas.emplace_back(schema);
+        std::erase(this->_building, key);
+    }
+    this->_built.notify_all();
+
+    if (complete && this->_directory.has_value() && !std::filesystem::exists(this->path(hash)))
+    {
+        this->save_orders(*schema);
+    }
+
+    return schema;
+}
+
+void SchemaCache::clear()
+{
+    std::lock_guard lock(this->_mutex);
+    this->_schemas.clear();
+    this->_statistics = Statistics();
+}
+
+size_t SchemaCache::size() const
+{
+    std::lock_guard lock(this->_mutex);
+    return this->_schemas.size();
+}
+
+Statistics SchemaCache::statistics() const
+{
+    std::lock_guard lock(this->_mutex);
+    return this->_statistics;
+}
+
+std::filesystem::path SchemaCache::path(uint64_t hash) const
+{
+    if (!this->_directory.has_value())
+    {
+        throw SchemaCacheError("schema cache has no directory");
+    }
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.schema", static_cast<unsigned long long>(hash));
+    return *this->_directory / name;
+}
+
+std::optional<PrioritizedOrders> SchemaCache::load_orders(uint64_t hash)
+{
+    std::ifstream in;
+    if (this->_directory.has_value())
+    {
+        in.open(this->path(hash), std::ios::binary);
+    }
+    if (!in)
+    {
+        std::lock_guard lock(this->_mutex);
+        this->_statistics.misses += 1;
+        return std::nullopt;
+    }
+
+    // A stale or corrupt file only costs the speedup
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::optional<PrioritizedOrders> orders;
+    if (data.size() >= sizeof(MAGIC) && data.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) == 0)
+    {
+        try
+        {
+            Reader reader(data);
+            reader.position = sizeof(MAGIC);
+            if (reader.read<uint32_t>() == VERSION && reader.read<uint64_t>() == hash)
+            {
+                orders.emplace();
+                auto count = reader.read<uint64_t>();
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    std::vector<uint32_t>& order = (*orders)[reader.read_string()];
+                    auto size = reader.read<uint32_t>();
+                    reader.require(size * sizeof(uint32_t));
+                    order.resize(size);
+                    for (uint32_t& index : order)
+                    {
+                        index = reader.read<uint32_t>();
+                    }
+                }
+            }
+        }
+        catch (const csgopp::error::Error&)
+        {
+            orders.reset();
+        }
+    }
+
+    std::lock_guard lock(this->_mutex);
+    (orders.has_value() ? this->_statistics.disk_hits : this->_statistics.misses) += 1;
+    return orders;
+}
+
+void SchemaCache::save_orders(const Schema& schema) const
+{
+    Writer writer;
+    writer.data.append(MAGIC, sizeof(MAGIC));
+    writer.write<uint32_t>(VERSION);
+    writer.write<uint64_t>(schema.hash);
+
+    size_t count = 0;
+    for (const std::shared_ptr<DataTable>& data_table : schema.data_tables)
+    {
+        count += data_table->type() != nullptr;
+    }
+
+    writer.write<uint64_t>(count);
+    for (const std::shared_ptr<DataTable>& data_table : schema.data_tables)
+    {
+        if (data_table->type() != nullptr)
+        {
+            writer.write(data_table->name);
+            writer.write<uint32_t>(static_cast<uint32_t>(data_table->prioritized_order().size()));
+            for (uint32_t index : data_table->prioritized_order())
+            {
+                writer.write<uint32_t>(index);
+            }
+        }
+    }
+
+    // Renamed into place so concurrent readers never see a partial file
+    std::filesystem::path path = this->path(schema.hash);
+    std::filesystem::path temporary = path;
+    temporary += "." + std::to_string(std::random_device()()) + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary);
+        out.write(writer.data.data(), static_cast<std::streamsize>(writer.data.size()));
+        if (!out)
+        {
+            throw SchemaCacheError("failed to write " + temporary.string());
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error)
+    {
+        std::filesystem::remove(temporary, error);
+        throw SchemaCacheError("failed to write " + path.string());
+    }
+}
+
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "../common/database.h"
+#include "../error.h"
+#include "data_table.h"
+#include "server_class.h"
+
+/// Reusing schemas across demos from the same game build.
+///
+/// Every demo recorded on a given build carries byte-for-byte the same send
+/// tables, yet building data tables, server classes and entity types from
+/// them is a large part of sign-on. A schema cache recognizes send tables
+/// by an FNV-1a hash of the `DATA_TABLES` frame and hands back the finished
+/// schema. Given a directory, it also keeps each data table's prioritized
+/// property order on disk, so a fresh process skips the prioritization pass.
+///
+/// Schemas are immutable once built and may be shared by clients on any
+/// number of threads; `SchemaCache::shared` is a process-wide registry for
+/// that purpose.
+namespace csgopp::client::schema_cache
+{
+
+using csgopp::client::data_table::DataTable;
+using csgopp::client::data_table::DataTableDatabase;
+using csgopp::client::data_table::PrioritizedOrders;
+using csgopp::client::server_class::ServerClass;
+using csgopp::common::database::Database;
+
+class SchemaCacheError : public csgopp::error::Error
+{
+    using Error::Error;
+};
+
+/// \brief Data tables and server classes with their types constructed.
+struct Schema
+{
+    uint64_t hash{};
+    /// String layout the types were built with, see `Client::set_inline_strings`.
+    bool inline_strings{};
+    DataTableDatabase data_tables;
+    Database<ServerClass> server_classes;
+    /// Prioritized orders read from disk, for types constructed later on
+    std::optional<PrioritizedOrders> orders;
+};
+
+struct Statistics
+{
+    /// Schemas found in memory
+    uint64_t hits{0};
+    /// Schemas built with prioritized orders read from disk
+    uint64_t disk_hits{0};
+    /// Schemas built from scratch
+    uint64_t misses{0};
+};
+
+class SchemaCache
+{
+public:
+    static constexpr char MAGIC[8] = {'C', 'S', 'G', 'O', 'P', 'P', 'S', 'C'};
+    static constexpr uint32_t VERSION = 1;
+
+    /// \brief Fill in a schema, given prioritized orders from disk if any.
+    using Build = std::function<void(Schema& schema, const PrioritizedOrders* orders)>;
+
+    /// \brief Cache schemas in memory only.
+    SchemaCache() = default;
+
+    /// \brief Also keep prioritized orders in a directory, created if needed.
+    explicit SchemaCache(std::filesystem::path directory);
+
+    /// \brief The process-wide cache, which keeps schemas in memory only.
+    static const std::shared_ptr<SchemaCache>& shared();
+
+    /// \brief Get the schema for send tables with the given hash, building it if needed.
+    ///
+    /// Safe to call from any thread. Only one thread builds a given schema;
+    /// others asking for it meanwhile wait and share the result. If the
+    /// build throws, the error propagates to its caller only and the next
+    /// caller builds again. Orders are saved to disk after a build if
+    /// they're not there yet and every server class has its type; schemas
+    /// whose types are constructed lazily don't save any.
+    ///
+    /// \throws SchemaCacheError if the orders can't be written.
+    [[nodiscard]] std::shared_ptr<const Schema> get(uint64_t hash, bool inline_strings, const Build& build);
+
+    /// \brief Get the prioritized orders saved for a schema, if any.
+    [[nodiscard]] std::optional<PrioritizedOrders> load_orders(uint64_t hash);
+
+    /// \brief Write a schema's prioritized orders to disk.
+    void save_orders(const Schema& schema) const;
+
+    /// \brief The file holding prioritized orders for a hash.
+    [[nodiscard]] std::filesystem::path path(uint64_t hash) const;
+
+    /// \brief Drop every schema and reset statistics.
+    ///
+    /// Clients already using a schema keep it alive.
+    void clear();
+
+    [[nodiscard]] const std::optional<std::filesystem::path>& directory() const { return this->_directory; }
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] Statistics statistics() const;
+
+private:
+    using Key = std::pair<uint64_t, bool>;
+
+    std::optional<std::filesystem::path> _directory;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _built;
+    std::vector<std::shared_ptr<const Schema>> _schemas;
+    /// Schemas some thread is building
+    std::vector<Key> _building;
+    Statistics _statistics;
+
+    [[nodiscard]] std::shared_ptr<const Schema> find(const Key& key) const;
+};
+
+}
@@ -1,11 +1,173 @@
 #include "server_class.h"
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+#include "../common/pool.h"
+
 namespace csgopp::client::server_class
 {
 
+using csgopp::common::pool::Pool;
+
 std::shared_ptr<const EntityType> ServerClass::type() const
 {
     return this->data_table->type();
 }
 
-}
\ No newline at end of file
+/// A data table whose type is built once all of its dependencies are
+struct ConstructionNode
+{
+    DataTable* data_table{nullptr};
+    std::vector<ConstructionNode*> dependents;
+    std::atomic<size_t> remaining{0};
+};
+
+/// The data tables whose types `construct_type` would build first
+static std::vector<DataTable*> dependencies(const DataTable* data_table)
+{
+    std::vector<DataTable*> result;
+    std::shared_ptr<ServerClass> server_class = data_table->server_class.lock();
+    if (!data_table->is_array && server_class != nullptr && server_class->base_class != nullptr)
+    {
+        result.push_back(server_class->base_class->data_table.get());
+    }
+
+    // Arrays only construct the type of their first element
+    size_t count = data_table->is_array ? std::min<size_t>(data_table->properties.size(), 1) : data_table->properties.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto property = dynamic_cast<const DataTable::DataTableProperty*>(data_table->properties.at(i).get());
+        if (property != nullptr && property->data_table != nullptr)
+        {
+            result.push_back(property->data_table.get());
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+static ConstructionNode* discover(
+    DataTable* data_table,
+    std::deque<ConstructionNode>& nodes,
+    absl::flat_hash_map<const DataTable*, ConstructionNode*>& lookup
+)
+{
+    auto [iterator, inserted] = lookup.emplace(data_table, nullptr);
+    if (!inserted)
+    {
+        return iterator->second;
+    }
+
+    ConstructionNode& node = nodes.emplace_back();
+    node.data_table = data_table;
+    iterator->second = &node;
+
+    std::vector<DataTable*> required = dependencies(data_table);
+    node.remaining.store(required.size(), std::memory_order_relaxed);
+    for (DataTable* dependency : required)
+    {
+        discover(dependency, nodes, lookup)->dependents.push_back(&node);
+    }
+
+    return &node;
+}
+
+void construct_types(const Database<ServerClass>& server_classes, const PrioritizedOrders* orders, size_t threads)
+{
+    if (threads == 1)
+    {
+        for (const std::shared_ptr<ServerClass>& server_class : server_classes)
+        {
+            server_class->data_table->construct_type(orders);
+        }
+        return;
+    }
+
+    // Deque so nodes don't move while we link them
+    std::deque<ConstructionNode> nodes;
+    absl::flat_hash_map<const DataTable*, ConstructionNode*> lookup;
+    for (const std::shared_ptr<ServerClass>& server_class : server_classes)
+    {
+        discover(server_class->data_table.get(), nodes, lookup);
+    }
+
+    Pool pool(threads);
+    std::mutex mutex;
+    std::exception_ptr error;
+    std::atomic<size_t> constructed{0};
+    std::atomic<bool> failed{false};
+
+    // A type is only read by its dependents after they're submitted, which
+    // happens after it's written
+    std::function<void(ConstructionNode*)> construct = [&](ConstructionNode* node)
+    {
+        if (failed.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        try
+        {
+            if (node->data_table->is_array)
+            {
+                node->data_table->construct_array_type();
+            }
+            else
+            {
+                node->data_table->construct_type(orders);
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard lock(mutex);
+            if (error == nullptr)
+            {
+                error = std::current_exception();
+            }
+            failed.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        constructed.fetch_add(1, std::memory_order_relaxed);
+        for (ConstructionNode* dependent : node->dependents)
+        {
+            if (dependent->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                pool.submit([&construct, dependent]() { construct(dependent); });
+            }
+        }
+    };
+
+    // Find the leaves before any task can bring another node to zero
+    std::vector<ConstructionNode*> leaves;
+    for (ConstructionNode& node : nodes)
+    {
+        if (node.remaining.load(std::memory_order_relaxed) == 0)
+        {
+            leaves.push_back(&node);
+        }
+    }
+    for (ConstructionNode* leaf : leaves)
+    {
+        pool.submit([&construct, leaf]() { construct(leaf); });
+    }
+    pool.wait();
+
+    if (error != nullptr)
+    {
+        std::rethrow_exception(error);
+    }
+    if (constructed.load(std::memory_order_relaxed) != nodes.size())
+    {
+        throw GameError("data tables depend on each other in a cycle");
+    }
+}
+
+}
@@ -21,6 +21,7 @@ namespace csgopp::client::server_class
 {
 
 using csgopp::client::data_table::DataTable;
+using csgopp::client::data_table::PrioritizedOrders;
 using csgopp::client::entity::EntityType;
 using csgopp::common::database::Database;
 using csgopp::common::database::DatabaseWithName;
@@ -41,4 +42,15 @@ struct ServerClass
 
 using ServerClassDatabase = DatabaseWithName<ServerClass>;
 
+/// \brief Construct the entity type of every server class.
+///
+/// With more than one thread, each data table's type is built on a pool as
+/// soon as the types it embeds, i.e. its base class and nested data tables,
+/// are ready. The result is the same as constructing the types one by one.
+///
+/// \param orders prioritized orders to pass to `DataTable::construct_type`.
+/// \param threads the number of workers, zero for the hardware count.
+/// \throws GameError if the data tables depend on each other in a cycle.
+void construct_types(const Database<ServerClass>& server_classes, const PrioritizedOrders* orders = nullptr, size_t threads = 1);
+
 }
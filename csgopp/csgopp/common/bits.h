@@ -1,9 +1,20 @@
 #pragma once
 
-#include <vector>
+#include <algorithm>
+#include <bit>
 #include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
 #include <google/protobuf/io/coded_stream.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CSGOPP_SSE2
+#endif
+
 #include "./macro.h"
 
 /// Defines tools for manipulating compressed bit streams.
@@ -33,9 +44,53 @@ constexpr S width(T t)
     return width;
 }
 
+/// The number of bytes scanned at once when reading strings.
+constexpr size_t STRING_BLOCK_SIZE = 32;
+
+/// \brief Find the first zero byte in a block of `STRING_BLOCK_SIZE` bytes.
+///
+/// Only the first `size` bytes are considered; the rest of the block must
+/// be readable but its contents are ignored. Uses AVX2 or SSE2 when the
+/// target supports them and a scalar search otherwise.
+///
+/// \return the index of the zero byte, or `size` if there is none.
+inline size_t find_zero(const uint8_t (&block)[STRING_BLOCK_SIZE], size_t size)
+{
+#if defined(__AVX2__)
+    __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_setzero_si256())));
+#elif defined(CSGOPP_SSE2)
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16));
+    auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(low, _mm_setzero_si128())))
+        | static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(high, _mm_setzero_si128()))) << 16;
+#else
+    const void* zero = std::memchr(block, 0, size);
+    return zero != nullptr ? static_cast<const uint8_t*>(zero) - block : size;
+#endif
+#if defined(__AVX2__) || defined(CSGOPP_SSE2)
+    if (size < STRING_BLOCK_SIZE)
+    {
+        mask &= (uint32_t(1) << size) - 1;
+    }
+    return mask != 0 ? static_cast<size_t>(std::countr_zero(mask)) : size;
+#endif
+}
+
+/// \brief A little-endian bit reader over a borrowed byte buffer.
+///
+/// Rather than shifting bytes into a buffer one at a time, every read does
+/// a single unaligned 64-bit load at the byte containing the cursor. After
+/// discarding up to seven leading bits that leaves at least 57 valid bits,
+/// so any field of that width is extracted with a shift and a mask. Loads
+/// within the last eight bytes go through a zero-padded copy instead of
+/// reading past the end of the buffer.
 class BitView
 {
 public:
+    /// The widest field that can be read with a single load.
+    static constexpr size_t MAX_SINGLE_READ = 57;
+
     explicit BitView(const std::string& string)
         : data(reinterpret_cast<const uint8_t*>(string.data())), data_size(string.size())
     {
@@ -53,102 +108,134 @@ public:
 
     void reset()
     {
-        this->data_index = 0;
-        this->buffer = 0;
-        this->buffer_size = 0;
+        this->position = 0;
     }
 
     bool skip(size_t bits)
     {
-        if (bits > this->buffer_size)
+        if (bits > this->remaining())
         {
-            bits -= this->buffer_size;
-            this->data_index += bits / 8;
-            if (this->data_index >= this->data_size)
-            {
-                return false;
-            }
-
-            bits %= 8;
+            this->position = this->data_size * 8;
+            return false;
         }
 
-        this->buffer_size -= bits;
-        this->buffer >>= bits;
+        this->position += bits;
         return true;
     }
 
     template<typename T>
     bool read(T* value, size_t bits)
     {
-        *value = 0;
-        if (bits == 0)
+        if (bits > this->remaining())
         {
-            return true;
+            *value = 0;
+            return false;
         }
 
-        size_t value_size{0};
-        do
+        if (bits <= MAX_SINGLE_READ)
         {
-            if (this->buffer_size == 0)
-            {
-                if (!this->fetch())
-                {
-                    return false;
-                }
-            }
-
-            *value |= this->buffer << value_size;
-            if (bits > this->buffer_size)
-            {
-                bits -= this->buffer_size;
-                value_size += this->buffer_size;
-                this->buffer_size = 0;
-            } else
-            {
-                *value &= ((static_cast<size_t>(1) << (bits + value_size)) - 1);
-                this->buffer >>= bits;
-                this->buffer_size -= bits;
-                break;
-            }
-        } while (bits > 0);
+            *value = static_cast<T>(this->peek(bits));
+            this->position += bits;
+        }
+        else
+        {
+            uint64_t low = this->peek(32);
+            this->position += 32;
+            uint64_t high = this->peek(bits - 32);
+            this->position += bits - 32;
+            *value = static_cast<T>(low | (high << 32));
+        }
 
         return true;
     }
 
+    /// \brief The number of bits consumed so far.
+    [[nodiscard]] size_t tell() const
+    {
+        return this->position;
+    }
+
+    /// \brief The number of bits left to read.
+    [[nodiscard]] size_t remaining() const
+    {
+        return this->data_size * 8 - this->position;
+    }
+
 protected:
-    bool fetch()
+    /// \brief Copy the next `count` whole bytes without consuming them.
+    ///
+    /// Bytes are reassembled across the bit offset eight at a time, so
+    /// `output` must have room for `count` rounded up to a multiple of
+    /// eight. The caller guarantees `count * 8 <= remaining()`.
+    void peek_bytes(uint8_t* output, size_t count) const
     {
-        if (this->data_index >= this->data_size)
+        size_t index = this->position / 8;
+        size_t shift = this->position % 8;
+        if (shift == 0)
         {
-            return false;
+            std::memcpy(output, this->data + index, count);
+            return;
+        }
+
+        for (size_t i = 0; i < count; i += 8)
+        {
+            uint64_t word = (this->load(index + i) >> shift) | (this->load(index + i + 8) << (64 - shift));
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                std::memcpy(output + i, &word, 8);
+            }
+            else
+            {
+                for (size_t j = 0; j < 8; ++j)
+                {
+                    output[i + j] = static_cast<uint8_t>(word >> (j * 8));
+                }
+            }
         }
+    }
 
-        this->buffer = static_cast<size_t>(this->data[this->data_index]);
-        this->buffer_size += 8;
-        this->data_index += 1;
+    /// \brief Get the next `bits` bits (at most 57) without consuming them.
+    [[nodiscard]] uint64_t peek(size_t bits) const
+    {
+        uint64_t word = this->load(this->position / 8) >> (this->position % 8);
+        return bits == 0 ? 0 : word & (~uint64_t(0) >> (64 - bits));
+    }
 
-        if (this->data_index == this->data_size)
+    /// \brief Load eight little-endian bytes, zero-filling past the end.
+    [[nodiscard]] uint64_t load(size_t index) const
+    {
+        uint8_t bytes[8]{};
+        if (index + 8 <= this->data_size)
         {
-            return true;
+            std::memcpy(bytes, this->data + index, 8);
+        }
+        else if (index < this->data_size)
+        {
+            // Bounded explicitly so the compiler can see it fits the buffer
+            size_t tail = this->data_size - index;
+            std::memcpy(bytes, this->data + index, std::min<size_t>(tail, 8));
         }
 
-        size_t counter{1};
-        do
+        uint64_t word;
+        if constexpr (std::endian::native == std::endian::little)
         {
-            this->buffer |= static_cast<size_t>(this->data[this->data_index]) << (counter * 8);
-            this->buffer_size += 8;
-            this->data_index += 1;
-            counter += 1;
-        } while (this->data_index < this->data_size && counter < sizeof(this->buffer));
-        return true;
+            std::memcpy(&word, bytes, 8);
+        }
+        else
+        {
+            word = 0;
+            for (size_t i = 0; i < 8; ++i)
+            {
+                word |= static_cast<uint64_t>(bytes[i]) << (i * 8);
+            }
+        }
+        return word;
     }
 
 private:
     const uint8_t* data;
     size_t data_size;
-    size_t data_index{0};
-    size_t buffer{0};
-    uint8_t buffer_size{0};
+    size_t position{0};
 };
 
 template<typename Source>
@@ -157,57 +244,46 @@ struct BitDecoder : Source
     using Source::Source;
 
     /// Read a C-style string into the given container.
+    ///
+    /// Whole blocks of bytes are extracted and searched for the terminator
+    /// at once rather than reading and appending one character at a time.
     bool read_string(std::string& string)
     {
-        do
+        auto append = [&string](const uint8_t* data, size_t length)
         {
-            string.push_back(0);
-            if (!this->read(&string.back(), 8))
-            {
-                return false;
-            }
-        } while (string.back() != 0);
-        string.pop_back();
-
-        return true;
+            string.append(reinterpret_cast<const char*>(data), length);
+        };
+        return this->read_string_block(append, SIZE_MAX) == Terminated::YES;
     }
 
+    /// Read a C-style string from a fixed-size field of `size` bytes.
+    ///
+    /// The whole field is consumed even if the terminator comes first.
     bool read_string_from(std::string& string, size_t size)
     {
         string.clear();
-        if (size == 0)
-        {
-            return true;
-        }
-
-        while (true)
-        {
-            string.push_back(0);
-            if (!this->read(&string.back(), 8))
-            {
-                return false;
-            }
-
-            size -= 1;
-
-            if (string.back() == 0)
+        return this->read_field(
+            [&string](const uint8_t* data, size_t length)
             {
-                string.pop_back();
-                break;
-            }
+                string.append(reinterpret_cast<const char*>(data), length);
+            },
+            size);
+    }
 
-            if (size == 0)
+    /// Read a C-style string from a fixed-size field into a buffer.
+    ///
+    /// `buffer` must have room for `size` bytes; the terminator is not
+    /// written and the number of bytes copied is stored in `length`.
+    bool read_string_from(char* buffer, size_t size, size_t* length)
+    {
+        *length = 0;
+        return this->read_field(
+            [buffer, length](const uint8_t* data, size_t count)
             {
-                return true;
-            }
-        }
-
-        if (size > 0)
-        {
-            this->skip(size * 8);
-        }
-
-        return true;
+                std::memcpy(buffer + *length, data, count);
+                *length += count;
+            },
+            size);
     }
 
     template<typename T>
@@ -299,6 +375,122 @@ struct BitDecoder : Source
         *value = (*value & 0b11111) | (buffer << 5);
         return ok;
     }
+
+    /// \brief Read the gap before the next changed entity property.
+    ///
+    /// With the small increment optimization, a set bit means the next
+    /// property directly follows and a `01` prefix precedes a three bit
+    /// jump; otherwise the jump is a `read_compressed_uint16`. Every form
+    /// fits in sixteen bits, so this is a single peek rather than up to
+    /// four separate reads.
+    bool read_property_jump(bool small_increment, uint16_t* value)
+    {
+        uint64_t word = this->peek(16);
+        size_t bits = 0;
+        if (small_increment)
+        {
+            if (word & 0b1)
+            {
+                *value = 0;
+                return this->skip(1);
+            }
+            if (word & 0b10)
+            {
+                *value = static_cast<uint16_t>((word >> 2) & 0b111);
+                return this->skip(5);
+            }
+            word >>= 2;
+            bits = 2;
+        }
+
+        uint16_t low = word & 0b11111;
+        switch (word & 0b1100000)
+        {
+            case 0b0000000:
+                *value = low;
+                bits += 7;
+                break;
+            case 0b0100000:
+                *value = low | ((word >> 7) & 0b11) << 5;
+                bits += 9;
+                break;
+            case 0b1000000:
+                *value = low | ((word >> 7) & 0b1111) << 5;
+                bits += 11;
+                break;
+            default:
+                *value = low | ((word >> 7) & 0b1111111) << 5;
+                bits += 14;
+                break;
+        }
+        return this->skip(bits);
+    }
+
+private:
+    enum class Terminated
+    {
+        YES,
+        /// The limit was reached before a terminator.
+        LIMIT,
+        /// The input ended before a terminator.
+        TRUNCATED,
+    };
+
+    /// Consume a field of `size` bytes, passing everything before the
+    /// first terminator to `append`.
+    template<typename Append>
+    bool read_field(Append&& append, size_t size)
+    {
+        if (size == 0)
+        {
+            return true;
+        }
+
+        size_t start = this->tell();
+        if (this->read_string_block(append, size) == Terminated::TRUNCATED)
+        {
+            return false;
+        }
+
+        size_t consumed = (this->tell() - start) / 8;
+        if (size > consumed)
+        {
+            this->skip((size - consumed) * 8);
+        }
+
+        return true;
+    }
+
+    /// Pass bytes up to a terminator, which is consumed but not passed,
+    /// to `append`, or until `limit` bytes have been consumed.
+    template<typename Append>
+    Terminated read_string_block(Append& append, size_t limit)
+    {
+        // Padded since bytes are extracted eight at a time
+        alignas(32) uint8_t block[STRING_BLOCK_SIZE];
+        while (limit > 0)
+        {
+            size_t available = std::min({STRING_BLOCK_SIZE, this->remaining() / 8, limit});
+            if (available == 0)
+            {
+                return Terminated::TRUNCATED;
+            }
+
+            this->peek_bytes(block, available);
+            size_t length = find_zero(block, available);
+            append(block, length);
+            if (length < available)
+            {
+                this->skip((length + 1) * 8);
+                return Terminated::YES;
+            }
+
+            this->skip(available * 8);
+            limit -= available;
+        }
+
+        return Terminated::LIMIT;
+    }
 };
 
 using BitStream = BitDecoder<BitView>;
@@ -0,0 +1,335 @@
+#include "compression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <bzlib.h>
+#include <zlib.h>
+#include <zstd.h>
+
+namespace csgopp::common::compression
+{
+
+const char* describe_format(Format format)
+{
+    switch (format)
+    {
+        case Format::NONE:
+            return "none";
+        case Format::GZIP:
+            return "gzip";
+        case Format::ZSTD:
+            return "zstd";
+        case Format::BZIP2:
+            return "bzip2";
+        default:
+            return "unknown";
+    }
+}
+
+Format detect(const char* magic, size_t size)
+{
+    const auto* bytes = reinterpret_cast<const unsigned char*>(magic);
+    if (size >= 2 && bytes[0] == 0x1F && bytes[1] == 0x8B)
+    {
+        return Format::GZIP;
+    }
+    else if (size >= 4 && bytes[0] == 0x28 && bytes[1] == 0xB5 && bytes[2] == 0x2F && bytes[3] == 0xFD)
+    {
+        return Format::ZSTD;
+    }
+    else if (size >= 3 && bytes[0] == 'B' && bytes[1] == 'Z' && bytes[2] == 'h')
+    {
+        return Format::BZIP2;
+    }
+    return Format::NONE;
+}
+
+Format detect(const std::filesystem::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    char magic[4]{};
+    in.read(magic, sizeof(magic));
+    return detect(magic, static_cast<size_t>(in.gcount()));
+}
+
+uint64_t estimate_size(const std::filesystem::path& path)
+{
+    uint64_t size = std::filesystem::file_size(path);
+    std::ifstream in(path, std::ios::binary);
+    char header[18]{};  // The longest zstd frame header
+    in.read(header, sizeof(header));
+    auto count = static_cast<size_t>(in.gcount());
+
+    switch (detect(header, count))
+    {
+        case Format::NONE:
+            return size;
+        case Format::GZIP:
+        {
+            // The trailer ends with the little-endian size of the last member
+            unsigned char trailer[4]{};
+            in.clear();
+            in.seekg(-4, std::ios::end);
+            in.read(reinterpret_cast<char*>(trailer), sizeof(trailer));
+            if (in.gcount() == sizeof(trailer))
+            {
+                uint64_t recorded = trailer[0] | trailer[1] << 8 | trailer[2] << 16 | uint64_t(trailer[3]) << 24;
+                return std::max(recorded, size);
+            }
+            break;
+        }
+        case Format::ZSTD:
+        {
+            unsigned long long recorded = ZSTD_getFrameContentSize(header, count);
+            if (recorded != ZSTD_CONTENTSIZE_UNKNOWN && recorded != ZSTD_CONTENTSIZE_ERROR)
+            {
+                return std::max<uint64_t>(recorded, size);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return size * ESTIMATED_RATIO;
+}
+
+std::unique_ptr<Source> decompress(std::unique_ptr<Source> source, Format format)
+{
+    switch (format)
+    {
+        case Format::GZIP:
+            return std::make_unique<GzipSource>(std::move(source));
+        case Format::ZSTD:
+            return std::make_unique<ZstdSource>(std::move(source));
+        case Format::BZIP2:
+            return std::make_unique<Bzip2Source>(std::move(source));
+        default:
+            return source;
+    }
+}
+
+// Decompressor interfaces count in 32 bits
+static unsigned int clamp(size_t size)
+{
+    return static_cast<unsigned int>(std::min<size_t>(size, std::numeric_limits<unsigned int>::max()));
+}
+
+DecompressingSource::DecompressingSource(std::unique_ptr<Source> source)
+    : _source(std::move(source))
+    , _input(std::make_unique<char[]>(INPUT_SIZE))
+{
+}
+
+bool DecompressingSource::refill()
+{
+    if (this->_available == 0 && !this->_exhausted)
+    {
+        this->_available = this->_source->read(this->_input.get(), INPUT_SIZE);
+        this->_next = this->_input.get();
+        this->_exhausted = this->_available == 0;
+    }
+    return this->_available > 0;
+}
+
+struct GzipSource::State
+{
+    z_stream stream{};
+    bool finished{false};
+};
+
+GzipSource::GzipSource(std::unique_ptr<Source> source)
+    : DecompressingSource(std::move(source))
+    , _state(std::make_unique<State>())
+{
+    // Window bits + 32 detects both gzip and zlib headers
+    if (inflateInit2(&this->_state->stream, MAX_WBITS + 32) != Z_OK)
+    {
+        throw CompressionError("failed to initialize gzip decompression");
+    }
+}
+
+GzipSource::~GzipSource()
+{
+    inflateEnd(&this->_state->stream);
+}
+
+size_t GzipSource::read(char* buffer, size_t size)
+{
+    z_stream& stream = this->_state->stream;
+    size_t produced = 0;
+    while (produced == 0)
+    {
+        if (!this->refill())
+        {
+            if (!this->_state->finished)
+            {
+                throw CompressionError("gzip stream is truncated");
+            }
+            return 0;
+        }
+
+        // Another member follows the one that just ended
+        if (this->_state->finished)
+        {
+            inflateReset(&stream);
+            this->_state->finished = false;
+        }
+
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(this->_next));
+        stream.avail_in = clamp(this->_available);
+        stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = clamp(size);
+
+        unsigned int available_in = stream.avail_in;
+        unsigned int available_out = stream.avail_out;
+        int result = inflate(&stream, Z_NO_FLUSH);
+        if (result == Z_STREAM_END)
+        {
+            this->_state->finished = true;
+        }
+        else if (result != Z_OK && result != Z_BUF_ERROR)
+        {
+            throw CompressionError(std::string("gzip decompression failed: ") + (stream.msg ? stream.msg : "unknown error"));
+        }
+
+        size_t consumed = available_in - stream.avail_in;
+        this->_next += consumed;
+        this->_available -= consumed;
+        produced = available_out - stream.avail_out;
+    }
+
+    return produced;
+}
+
+struct ZstdSource::State
+{
+    ZSTD_DCtx* context{nullptr};
+    bool finished{false};
+};
+
+ZstdSource::ZstdSource(std::unique_ptr<Source> source)
+    : DecompressingSource(std::move(source))
+    , _state(std::make_unique<State>())
+{
+    this->_state->context = ZSTD_createDCtx();
+    if (this->_state->context == nullptr)
+    {
+        throw CompressionError("failed to initialize zstd decompression");
+    }
+}
+
+ZstdSource::~ZstdSource()
+{
+    ZSTD_freeDCtx(this->_state->context);
+}
+
+size_t ZstdSource::read(char* buffer, size_t size)
+{
+    size_t produced = 0;
+    while (produced == 0)
+    {
+        if (!this->refill())
+        {
+            if (!this->_state->finished)
+            {
+                throw CompressionError("zstd stream is truncated");
+            }
+            return 0;
+        }
+
+        ZSTD_inBuffer input{this->_next, this->_available, 0};
+        ZSTD_outBuffer output{buffer, size, 0};
+        size_t result = ZSTD_decompressStream(this->_state->context, &output, &input);
+        if (ZSTD_isError(result))
+        {
+            throw CompressionError(std::string("zstd decompression failed: ") + ZSTD_getErrorName(result));
+        }
+
+        // Zero means a frame just ended; another may follow
+        this->_state->finished = result == 0;
+        this->_next += input.pos;
+        this->_available -= input.pos;
+        produced = output.pos;
+    }
+
+    return produced;
+}
+
+struct Bzip2Source::State
+{
+    bz_stream stream{};
+    bool finished{false};
+};
+
+Bzip2Source::Bzip2Source(std::unique_ptr<Source> source)
+    : DecompressingSource(std::move(source))
+    , _state(std::make_unique<State>())
+{
+    if (BZ2_bzDecompressInit(&this->_state->stream, 0, 0) != BZ_OK)
+    {
+        throw CompressionError("failed to initialize bzip2 decompression");
+    }
+}
+
+Bzip2Source::~Bzip2Source()
+{
+    BZ2_bzDecompressEnd(&this->_state->stream);
+}
+
+size_t Bzip2Source::read(char* buffer, size_t size)
+{
+    bz_stream& stream = this->_state->stream;
+    size_t produced = 0;
+    while (produced == 0)
+    {
+        if (!this->refill())
+        {
+            if (!this->_state->finished)
+            {
+                throw CompressionError("bzip2 stream is truncated");
+            }
+            return 0;
+        }
+
+        // Another stream follows the one that just ended
+        if (this->_state->finished)
+        {
+            BZ2_bzDecompressEnd(&stream);
+            stream = bz_stream{};
+            if (BZ2_bzDecompressInit(&stream, 0, 0) != BZ_OK)
+            {
+                throw CompressionError("failed to initialize bzip2 decompression");
+            }
+            this->_state->finished = false;
+        }
+
+        stream.next_in = const_cast<char*>(this->_next);
+        stream.avail_in = clamp(this->_available);
+        stream.next_out = buffer;
+        stream.avail_out = clamp(size);
+
+        unsigned int available_in = stream.avail_in;
+        unsigned int available_out = stream.avail_out;
+        int result = BZ2_bzDecompress(&stream);
+        if (result == BZ_STREAM_END)
+        {
+            this->_state->finished = true;
+        }
+        else if (result != BZ_OK)
+        {
+            throw CompressionError("bzip2 decompression failed with code " + std::to_string(result));
+        }
+
+        size_t consumed = available_in - stream.avail_in;
+        this->_next += consumed;
+        this->_available -= consumed;
+        produced = available_out - stream.avail_out;
+    }
+
+    return produced;
+}
+
+}
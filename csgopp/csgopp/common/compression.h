@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+#include "../error.h"
+#include "read_ahead.h"
+
+/// Streaming decompression of archived demos.
+///
+/// Each decompressor is a read-ahead `Source` wrapping another source, so
+/// decompression happens on the read-ahead thread and the parser consumes
+/// plain demo bytes without anything touching the disk.
+namespace csgopp::common::compression
+{
+
+using csgopp::common::read_ahead::Source;
+
+class CompressionError : public csgopp::error::Error
+{
+    using Error::Error;
+};
+
+enum class Format
+{
+    NONE,
+    GZIP,
+    ZSTD,
+    BZIP2,
+};
+
+const char* describe_format(Format format);
+
+/// \brief Identify a compression format from the leading bytes of a file.
+Format detect(const char* magic, size_t size);
+
+/// \brief Identify the compression format of a file by its magic bytes.
+Format detect(const std::filesystem::path& path);
+
+/// Assumed when a compressed file doesn't record how large it decompresses.
+constexpr uint64_t ESTIMATED_RATIO = 4;
+
+/// \brief Estimate the decompressed size of a file without decompressing it.
+///
+/// gzip records the size of its last member (modulo 4 GiB) and zstd frames
+/// usually record their content size; bzip2 records nothing, so it and any
+/// file missing a size is assumed to have shrunk by `ESTIMATED_RATIO`. A
+/// recorded size is never taken to be smaller than the file itself.
+///
+/// \param path the file, compressed or not.
+/// \return the estimated size in bytes.
+uint64_t estimate_size(const std::filesystem::path& path);
+
+/// \brief Wrap a source in a decompressor for the given format.
+///
+/// `Format::NONE` returns the source unchanged.
+std::unique_ptr<Source> decompress(std::unique_ptr<Source> source, Format format);
+
+/// Shared input buffering for the decompressors below.
+class DecompressingSource : public Source
+{
+public:
+    static constexpr size_t INPUT_SIZE = 256 << 10;
+
+    explicit DecompressingSource(std::unique_ptr<Source> source);
+
+protected:
+    /// \brief Read more compressed input if the buffer has been consumed.
+    /// \return whether compressed input remains.
+    bool refill();
+
+    std::unique_ptr<Source> _source;
+    std::unique_ptr<char[]> _input;
+    const char* _next{nullptr};
+    size_t _available{0};
+    bool _exhausted{false};
+};
+
+/// \brief Decompresses gzip (or zlib) data, including concatenated members.
+class GzipSource final : public DecompressingSource
+{
+public:
+    explicit GzipSource(std::unique_ptr<Source> source);
+    ~GzipSource() override;
+
+    size_t read(char* buffer, size_t size) override;
+
+private:
+    struct State;
+    std::unique_ptr<State> _state;
+};
+
+/// \brief Decompresses zstd data, including concatenated frames.
+class ZstdSource final : public DecompressingSource
+{
+public:
+    explicit ZstdSource(std::unique_ptr<Source> source);
+    ~ZstdSource() override;
+
+    size_t read(char* buffer, size_t size) override;
+
+private:
+    struct State;
+    std::unique_ptr<State> _state;
+};
+
+/// \brief Decompresses bzip2 data, including concatenated streams.
+class Bzip2Source final : public DecompressingSource
+{
+public:
+    explicit Bzip2Source(std::unique_ptr<Source> source);
+    ~Bzip2Source() override;
+
+    size_t read(char* buffer, size_t size) override;
+
+private:
+    struct State;
+    std::unique_ptr<State> _state;
+};
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace csgopp::common::hash
+{
+
+constexpr uint64_t FNV_OFFSET = 0xCBF29CE484222325;
+constexpr uint64_t FNV_PRIME = 0x100000001B3;
+
+/// \brief Hash bytes with 64 bit FNV-1a.
+///
+/// Passing a previous result as the seed continues the hash, so data read
+/// in pieces hashes the same as if it had been read at once.
+constexpr uint64_t fnv1a(std::string_view data, uint64_t seed = FNV_OFFSET)
+{
+    uint64_t result = seed;
+    for (char c : data)
+    {
+        result ^= static_cast<uint8_t>(c);
+        result *= FNV_PRIME;
+    }
+    return result;
+}
+
+}
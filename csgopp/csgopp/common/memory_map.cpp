@@ -0,0 +1,185 @@
+#include "memory_map.h"
+#include "macro.h"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace csgopp::common::memory_map
+{
+
+#ifdef _WIN32
+
+MemoryMap::MemoryMap(const std::filesystem::path& path)
+{
+    HANDLE file = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw MemoryMapError("failed to open " + path.string());
+    }
+    this->_file = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        throw MemoryMapError("failed to stat " + path.string());
+    }
+    this->_size = static_cast<size_t>(size.QuadPart);
+
+    if (this->_size > 0)
+    {
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            CloseHandle(file);
+            throw MemoryMapError("failed to map " + path.string());
+        }
+        this->_mapping = mapping;
+        this->_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (this->_data == nullptr)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            throw MemoryMapError("failed to map " + path.string());
+        }
+    }
+}
+
+MemoryMap::~MemoryMap()
+{
+    if (this->_data != nullptr)
+    {
+        UnmapViewOfFile(this->_data);
+    }
+    if (this->_mapping != nullptr)
+    {
+        CloseHandle(this->_mapping);
+    }
+    if (this->_file != nullptr)
+    {
+        CloseHandle(this->_file);
+    }
+}
+
+#else
+
+MemoryMap::MemoryMap(const std::filesystem::path& path)
+{
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+        throw MemoryMapError("failed to open " + path.string());
+    }
+
+    struct stat status{};
+    if (fstat(descriptor, &status) != 0)
+    {
+        ::close(descriptor);
+        throw MemoryMapError("failed to stat " + path.string());
+    }
+    this->_size = static_cast<size_t>(status.st_size);
+
+    // Zero-length mappings are invalid; an empty file simply has no data
+    if (this->_size > 0)
+    {
+        void* address = mmap(nullptr, this->_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (address == MAP_FAILED)
+        {
+            ::close(descriptor);
+            throw MemoryMapError("failed to map " + path.string());
+        }
+        this->_data = static_cast<const char*>(address);
+
+        // Hints only, ignore failure
+        madvise(address, this->_size, MADV_SEQUENTIAL);
+        madvise(address, this->_size, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+        madvise(address, this->_size, MADV_HUGEPAGE);
+#endif
+    }
+
+    // The mapping holds its own reference to the file
+    ::close(descriptor);
+}
+
+MemoryMap::~MemoryMap()
+{
+    if (this->_data != nullptr)
+    {
+        munmap(const_cast<char*>(this->_data), this->_size);
+    }
+}
+
+#endif
+
+MemoryMappedInputStream::MemoryMappedInputStream(const std::filesystem::path& path) : _map(path)
+{
+}
+
+bool MemoryMappedInputStream::Next(const void** data, int* size)
+{
+    if (this->_position >= this->_map.size())
+    {
+        this->_last_size = 0;
+        return false;
+    }
+
+    // Hand out as much as the interface allows; demos are well under this
+    size_t available = std::min(
+        this->_map.size() - this->_position,
+        static_cast<size_t>(std::numeric_limits<int>::max())
+    );
+
+    *data = this->_map.data() + this->_position;
+    *size = static_cast<int>(available);
+    this->_position += available;
+    this->_last_size = available;
+    return true;
+}
+
+void MemoryMappedInputStream::BackUp(int count)
+{
+    OK(count >= 0 && static_cast<size_t>(count) <= this->_last_size);
+    this->_position -= count;
+    this->_last_size = 0;
+}
+
+bool MemoryMappedInputStream::Skip(int count)
+{
+    OK(count >= 0);
+    this->_last_size = 0;
+    size_t remaining = this->_map.size() - this->_position;
+    if (static_cast<size_t>(count) > remaining)
+    {
+        this->_position = this->_map.size();
+        return false;
+    }
+
+    this->_position += count;
+    return true;
+}
+
+int64_t MemoryMappedInputStream::ByteCount() const
+{
+    return static_cast<int64_t>(this->_position);
+}
+
+}
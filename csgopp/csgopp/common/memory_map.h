@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <google/protobuf/io/zero_copy_stream.h>
+
+#include "../error.h"
+
+/// Zero-copy access to files through the operating system's page cache.
+namespace csgopp::common::memory_map
+{
+
+using google::protobuf::io::ZeroCopyInputStream;
+
+class MemoryMapError : public csgopp::error::Error
+{
+    using Error::Error;
+};
+
+/// \brief A read-only mapping of an entire file.
+///
+/// The mapping is advised as sequential (and, where supported, as a
+/// candidate for transparent huge pages) since demos are read front to back.
+/// Hints are best-effort; failing to apply one is not an error.
+class MemoryMap
+{
+public:
+    explicit MemoryMap(const std::filesystem::path& path);
+    ~MemoryMap();
+
+    MemoryMap(const MemoryMap&) = delete;
+    MemoryMap& operator=(const MemoryMap&) = delete;
+
+    [[nodiscard]] const char* data() const { return this->_data; }
+    [[nodiscard]] size_t size() const { return this->_size; }
+
+private:
+    const char* _data{nullptr};
+    size_t _size{0};
+
+#ifdef _WIN32
+    void* _file{nullptr};
+    void* _mapping{nullptr};
+#endif
+};
+
+/// \brief A `ZeroCopyInputStream` that hands out slices of a `MemoryMap`.
+///
+/// `CodedInputStream` reads directly from the mapped pages, so there is no
+/// intermediate buffer between the page cache and the parser.
+class MemoryMappedInputStream final : public ZeroCopyInputStream
+{
+public:
+    explicit MemoryMappedInputStream(const std::filesystem::path& path);
+
+    bool Next(const void** data, int* size) override;
+    void BackUp(int count) override;
+    bool Skip(int count) override;
+    [[nodiscard]] int64_t ByteCount() const override;
+
+    [[nodiscard]] const MemoryMap& map() const { return this->_map; }
+
+private:
+    MemoryMap _map;
+    size_t _position{0};
+    size_t _last_size{0};
+};
+
+}
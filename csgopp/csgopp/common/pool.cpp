@@ -0,0 +1,159 @@
+#include "pool.h"
+
+#include <algorithm>
+
+namespace csgopp::common::pool
+{
+
+// Lets tasks that submit more work push onto their own worker's queue
+static thread_local Pool* current_pool = nullptr;
+static thread_local size_t current_index = 0;
+
+Pool::Pool(size_t threads)
+{
+    if (threads == 0)
+    {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    this->_queues.reserve(threads);
+    for (size_t i = 0; i < threads; ++i)
+    {
+        this->_queues.emplace_back(std::make_unique<Queue>());
+    }
+
+    this->_workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i)
+    {
+        this->_workers.emplace_back(&Pool::work, this, i);
+    }
+}
+
+Pool::~Pool()
+{
+    {
+        std::lock_guard lock(this->_mutex);
+        this->_stopping = true;
+    }
+    this->_available.notify_all();
+
+    for (std::thread& worker : this->_workers)
+    {
+        worker.join();
+    }
+}
+
+void Pool::submit(Task task)
+{
+    size_t index = current_pool == this
+        ? current_index
+        : this->_next.fetch_add(1, std::memory_order_relaxed) % this->_queues.size();
+
+    // Count before publishing so a fast worker never sees more tasks than _queued
+    {
+        std::lock_guard lock(this->_mutex);
+        this->_queued += 1;
+        this->_pending += 1;
+    }
+
+    {
+        Queue& queue = *this->_queues[index];
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    this->_available.notify_one();
+}
+
+void Pool::wait()
+{
+    std::unique_lock lock(this->_mutex);
+    this->_idle.wait(lock, [this]() { return this->_pending == 0; });
+}
+
+bool Pool::pop(size_t index, Task& task)
+{
+    bool found = false;
+
+    {
+        Queue& own = *this->_queues[index];
+        std::lock_guard lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+
+    for (size_t offset = 1; !found && offset < this->_queues.size(); ++offset)
+    {
+        Queue& victim = *this->_queues[(index + offset) % this->_queues.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            this->_steals.fetch_add(1, std::memory_order_relaxed);
+            found = true;
+        }
+    }
+
+    if (found)
+    {
+        std::lock_guard lock(this->_mutex);
+        this->_queued -= 1;
+    }
+
+    return found;
+}
+
+void Pool::work(size_t index)
+{
+    current_pool = this;
+    current_index = index;
+
+    while (true)
+    {
+        Task task;
+        if (this->pop(index, task))
+        {
+            task();
+
+            std::lock_guard lock(this->_mutex);
+            this->_pending -= 1;
+            if (this->_pending == 0)
+            {
+                this->_idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock lock(this->_mutex);
+        this->_available.wait(lock, [this]() { return this->_stopping || this->_queued > 0; });
+        if (this->_stopping && this->_queued == 0)
+        {
+            return;
+        }
+    }
+}
+
+size_t Budget::acquire(size_t units)
+{
+    units = std::min(units, this->_capacity);
+    std::unique_lock lock(this->_mutex);
+    this->_condition.wait(lock, [this, units]() { return this->_available >= units; });
+    this->_available -= units;
+    return units;
+}
+
+void Budget::release(size_t units)
+{
+    {
+        std::lock_guard lock(this->_mutex);
+        this->_available += units;
+    }
+    this->_condition.notify_all();
+}
+
+}
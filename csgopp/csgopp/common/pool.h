@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Scheduling primitives shared by the batch and schema construction code.
+namespace csgopp::common::pool
+{
+
+/// \brief A fixed-size thread pool with per-worker queues and stealing.
+///
+/// Each worker pops from the back of its own queue and, when that runs dry,
+/// steals from the front of its peers'. Tasks submitted from outside the
+/// pool are distributed round-robin, while tasks submitted from a worker
+/// land on that worker's own queue so related work stays on one core.
+class Pool
+{
+public:
+    using Task = std::function<void()>;
+
+    /// \param threads the number of workers, zero for the hardware count.
+    explicit Pool(size_t threads = 0);
+    ~Pool();
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    /// \brief Queue a task for execution.
+    void submit(Task task);
+
+    /// \brief Block until every submitted task has finished.
+    ///
+    /// Tasks must not throw; wrap them if they can.
+    void wait();
+
+    [[nodiscard]] size_t size() const { return this->_workers.size(); }
+
+    /// \brief Get the number of tasks a worker took from a peer.
+    [[nodiscard]] size_t steals() const { return this->_steals.load(std::memory_order_relaxed); }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void work(size_t index);
+    bool pop(size_t index, Task& task);
+
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _available;
+    std::condition_variable _idle;
+    size_t _queued{0};
+    size_t _pending{0};
+    bool _stopping{false};
+
+    std::atomic<size_t> _next{0};
+    std::atomic<size_t> _steals{0};
+};
+
+/// \brief A counting budget that blocks until enough units are free.
+///
+/// Requests larger than the whole budget are clamped so that a single
+/// oversized item can still run, just never alongside anything else.
+class Budget
+{
+public:
+    explicit Budget(size_t capacity) : _capacity(capacity), _available(capacity)
+    {
+    }
+
+    /// \brief Wait for and take units from the budget.
+    /// \return the number of units actually taken, to be passed to `release`.
+    size_t acquire(size_t units);
+    void release(size_t units);
+
+    [[nodiscard]] size_t capacity() const { return this->_capacity; }
+
+private:
+    size_t _capacity;
+    size_t _available;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+};
+
+/// \brief Units held from a `Budget` until destruction.
+class Reservation
+{
+public:
+    Reservation(Budget& budget, size_t units) : _budget(budget), _units(budget.acquire(units))
+    {
+    }
+
+    ~Reservation()
+    {
+        this->_budget.release(this->_units);
+    }
+
+    Reservation(const Reservation&) = delete;
+    Reservation& operator=(const Reservation&) = delete;
+
+    [[nodiscard]] size_t units() const { return this->_units; }
+
+private:
+    Budget& _budget;
+    size_t _units;
+};
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace csgopp::common::queue
+{
+
+// Fixed rather than std::hardware_destructive_interference_size, which
+// varies between compiler versions and so is unsafe in a header
+constexpr size_t CACHE_LINE = 64;
+
+/// \brief A bounded lock-free queue for exactly one producer and one consumer.
+///
+/// The head and tail live on separate cache lines and each side caches the
+/// other's index, so in the steady state a push or pop touches no shared
+/// line. Blocking is left to the caller; `produced` and `consumed` can be
+/// waited on with `std::atomic::wait` to sleep until the other side moves.
+template<typename T>
+class Queue
+{
+public:
+    explicit Queue(size_t capacity)
+        : _capacity(capacity + 1)
+        , _data(std::make_unique<std::optional<T>[]>(capacity + 1))
+    {
+    }
+
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+
+    /// \brief Push from the producer thread.
+    /// \return false if the queue is full; the item is untouched.
+    bool try_push(T&& item)
+    {
+        size_t tail = this->_tail.load(std::memory_order_relaxed);
+        size_t next = this->increment(tail);
+        if (next == this->_head_cache)
+        {
+            this->_head_cache = this->_head.load(std::memory_order_acquire);
+            if (next == this->_head_cache)
+            {
+                return false;
+            }
+        }
+
+        this->_data[tail].emplace(std::move(item));
+        this->_tail.store(next, std::memory_order_release);
+        this->produced.fetch_add(1, std::memory_order_release);
+        this->produced.notify_one();
+        return true;
+    }
+
+    /// \brief Pop from the consumer thread.
+    /// \return false if the queue is empty.
+    bool try_pop(T& item)
+    {
+        size_t head = this->_head.load(std::memory_order_relaxed);
+        if (head == this->_tail_cache)
+        {
+            this->_tail_cache = this->_tail.load(std::memory_order_acquire);
+            if (head == this->_tail_cache)
+            {
+                return false;
+            }
+        }
+
+        item = std::move(*this->_data[head]);
+        this->_data[head].reset();
+        this->_head.store(this->increment(head), std::memory_order_release);
+        this->consumed.fetch_add(1, std::memory_order_release);
+        this->consumed.notify_one();
+        return true;
+    }
+
+    /// \brief Approximate number of queued items.
+    [[nodiscard]] size_t size() const
+    {
+        size_t head = this->_head.load(std::memory_order_acquire);
+        size_t tail = this->_tail.load(std::memory_order_acquire);
+        return tail >= head ? tail - head : tail + this->_capacity - head;
+    }
+
+    [[nodiscard]] size_t capacity() const { return this->_capacity - 1; }
+
+    /// Monotonic counters for sleeping on the other side's progress.
+    alignas(CACHE_LINE) std::atomic<uint32_t> produced{0};
+    alignas(CACHE_LINE) std::atomic<uint32_t> consumed{0};
+
+private:
+    [[nodiscard]] size_t increment(size_t index) const
+    {
+        return index + 1 == this->_capacity ? 0 : index + 1;
+    }
+
+    const size_t _capacity;
+    std::unique_ptr<std::optional<T>[]> _data;
+
+    alignas(CACHE_LINE) std::atomic<size_t> _head{0};
+    size_t _tail_cache{0};
+
+    alignas(CACHE_LINE) std::atomic<size_t> _tail{0};
+    size_t _head_cache{0};
+};
+
+}
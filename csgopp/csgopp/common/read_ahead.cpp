@@ -0,0 +1,300 @@
+#include "read_ahead.h"
+#include "macro.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <limits>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace csgopp::common::read_ahead
+{
+
+#ifdef _WIN32
+
+FileSource::FileSource(const std::filesystem::path& path)
+{
+    HANDLE handle = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr
+    );
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        throw ReadAheadError("failed to open " + path.string());
+    }
+    this->_handle = handle;
+}
+
+FileSource::~FileSource()
+{
+    CloseHandle(this->_handle);
+}
+
+size_t FileSource::read(char* buffer, size_t size)
+{
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(this->_offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(this->_offset >> 32);
+
+    DWORD count = 0;
+    DWORD request = static_cast<DWORD>(std::min<size_t>(size, std::numeric_limits<DWORD>::max()));
+    if (!ReadFile(this->_handle, buffer, request, &count, &overlapped))
+    {
+        if (GetLastError() == ERROR_HANDLE_EOF)
+        {
+            return 0;
+        }
+        throw ReadAheadError("failed to read at offset " + std::to_string(this->_offset));
+    }
+
+    this->_offset += count;
+    return count;
+}
+
+#else
+
+FileSource::FileSource(const std::filesystem::path& path)
+{
+    this->_descriptor = ::open(path.c_str(), O_RDONLY);
+    if (this->_descriptor < 0)
+    {
+        throw ReadAheadError("failed to open " + path.string());
+    }
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    // Hint only, ignore failure
+    posix_fadvise(this->_descriptor, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+FileSource::~FileSource()
+{
+    ::close(this->_descriptor);
+}
+
+size_t FileSource::read(char* buffer, size_t size)
+{
+    while (true)
+    {
+        ssize_t count = pread(this->_descriptor, buffer, size, static_cast<off_t>(this->_offset));
+        if (count >= 0)
+        {
+            this->_offset += count;
+            return static_cast<size_t>(count);
+        }
+        else if (errno != EINTR)
+        {
+            throw ReadAheadError("failed to read at offset " + std::to_string(this->_offset));
+        }
+    }
+}
+
+#endif
+
+ReadAheadInputStream::ReadAheadInputStream(std::unique_ptr<Source> source, size_t buffer_size, size_t depth)
+    : _source(std::move(source))
+    , _buffer_size(buffer_size)
+    , _depth(depth)
+    , _full(depth + 1)  // Room for every buffer plus the end marker
+    , _free(depth)
+{
+    OK(buffer_size > 0 && buffer_size <= static_cast<size_t>(std::numeric_limits<int>::max()));
+    OK(depth > 0);
+
+    for (size_t i = 0; i < depth; ++i)
+    {
+        Buffer buffer{std::make_unique<char[]>(buffer_size), 0};
+        OK(this->_free.try_push(std::move(buffer)));
+    }
+
+    this->_thread = std::thread(&ReadAheadInputStream::produce, this);
+}
+
+ReadAheadInputStream::~ReadAheadInputStream()
+{
+    this->_stopping.store(true, std::memory_order_release);
+
+    // Wake the producer if it's waiting on a free buffer
+    this->_free.produced.fetch_add(1, std::memory_order_release);
+    this->_free.produced.notify_one();
+    this->_thread.join();
+}
+
+void ReadAheadInputStream::produce()
+{
+    try
+    {
+        while (!this->_stopping.load(std::memory_order_acquire))
+        {
+            Buffer buffer;
+            while (!this->_free.try_pop(buffer))
+            {
+                uint32_t seen = this->_free.produced.load(std::memory_order_acquire);
+                if (this->_stopping.load(std::memory_order_acquire))
+                {
+                    return;
+                }
+                if (this->_free.try_pop(buffer))
+                {
+                    break;
+                }
+                this->_free.produced.wait(seen, std::memory_order_acquire);
+            }
+
+            // Fill completely so the parser sees few, large buffers
+            bool end = false;
+            buffer.size = 0;
+            while (buffer.size < this->_buffer_size)
+            {
+                size_t count = this->_source->read(buffer.data.get() + buffer.size, this->_buffer_size - buffer.size);
+                if (count == 0)
+                {
+                    end = true;
+                    break;
+                }
+                buffer.size += count;
+            }
+
+            if (buffer.size > 0)
+            {
+                OK(this->_full.try_push(std::move(buffer)));
+            }
+
+            if (end)
+            {
+                break;
+            }
+        }
+    }
+    catch (...)
+    {
+        this->_error = std::current_exception();
+    }
+
+    // An empty buffer marks the end of input, published after any error
+    OK(this->_full.try_push(Buffer{}));
+}
+
+bool ReadAheadInputStream::acquire()
+{
+    if (this->_current.data != nullptr)
+    {
+        this->_current.size = 0;
+        OK(this->_free.try_push(std::move(this->_current)));
+    }
+
+    this->_position = 0;
+    if (!this->_full.try_pop(this->_current))
+    {
+        auto start = std::chrono::steady_clock::now();
+        while (true)
+        {
+            uint32_t seen = this->_full.produced.load(std::memory_order_acquire);
+            if (this->_full.try_pop(this->_current))
+            {
+                break;
+            }
+            this->_full.produced.wait(seen, std::memory_order_acquire);
+        }
+
+        this->_stalls += 1;
+        this->_stall_nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+
+    if (this->_current.data == nullptr)
+    {
+        this->_finished = true;
+        if (this->_error)
+        {
+            std::rethrow_exception(this->_error);
+        }
+        return false;
+    }
+
+    return true;
+}
+
+bool ReadAheadInputStream::Next(const void** data, int* size)
+{
+    while (this->_position >= this->_current.size)
+    {
+        if (this->_finished || !this->acquire())
+        {
+            this->_last_size = 0;
+            return false;
+        }
+    }
+
+    size_t available = this->_current.size - this->_position;
+    *data = this->_current.data.get() + this->_position;
+    *size = static_cast<int>(available);
+    this->_position += available;
+    this->_last_size = available;
+    this->_byte_count += static_cast<int64_t>(available);
+    return true;
+}
+
+void ReadAheadInputStream::BackUp(int count)
+{
+    OK(count >= 0 && static_cast<size_t>(count) <= this->_last_size);
+    this->_position -= count;
+    this->_byte_count -= count;
+    this->_last_size = 0;
+}
+
+bool ReadAheadInputStream::Skip(int count)
+{
+    OK(count >= 0);
+    this->_last_size = 0;
+
+    auto remaining = static_cast<size_t>(count);
+    while (remaining > 0)
+    {
+        if (this->_position >= this->_current.size)
+        {
+            if (this->_finished || !this->acquire())
+            {
+                return false;
+            }
+            continue;
+        }
+
+        size_t step = std::min(remaining, this->_current.size - this->_position);
+        this->_position += step;
+        this->_byte_count += static_cast<int64_t>(step);
+        remaining -= step;
+    }
+
+    return true;
+}
+
+int64_t ReadAheadInputStream::ByteCount() const
+{
+    return this->_byte_count;
+}
+
+Statistics ReadAheadInputStream::statistics() const
+{
+    Statistics statistics;
+    statistics.buffer_size = this->_buffer_size;
+    statistics.depth = this->_depth;
+    statistics.bytes = static_cast<uint64_t>(this->_byte_count);
+    statistics.stalls = this->_stalls;
+    statistics.stall_nanoseconds = this->_stall_nanoseconds;
+    return statistics;
+}
+
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <google/protobuf/io/zero_copy_stream.h>
+
+#include "../error.h"
+#include "queue.h"
+
+/// Reading ahead of the parser on a dedicated thread.
+namespace csgopp::common::read_ahead
+{
+
+using csgopp::common::queue::Queue;
+using google::protobuf::io::ZeroCopyInputStream;
+
+class ReadAheadError : public csgopp::error::Error
+{
+    using Error::Error;
+};
+
+/// \brief A sequential producer of bytes for the read-ahead thread.
+///
+/// Sources are only ever called from the read-ahead thread.
+class Source
+{
+public:
+    virtual ~Source() = default;
+
+    /// \brief Fill as much of the buffer as possible.
+    /// \return the number of bytes read, zero only at the end of input.
+    virtual size_t read(char* buffer, size_t size) = 0;
+};
+
+/// \brief Reads a file with positional reads (`pread` or overlapped
+///     `ReadFile`) so the kernel never has to track a shared file offset.
+class FileSource final : public Source
+{
+public:
+    explicit FileSource(const std::filesystem::path& path);
+    ~FileSource() override;
+
+    FileSource(const FileSource&) = delete;
+    FileSource& operator=(const FileSource&) = delete;
+
+    size_t read(char* buffer, size_t size) override;
+
+private:
+#ifdef _WIN32
+    void* _handle{nullptr};
+#else
+    int _descriptor{-1};
+#endif
+    uint64_t _offset{0};
+};
+
+struct Statistics
+{
+    size_t buffer_size{};
+    size_t depth{};
+    /// Bytes handed to the parser.
+    uint64_t bytes{};
+    /// Times the parser found no buffer ready and had to wait.
+    uint64_t stalls{};
+    /// Total time the parser spent waiting, in nanoseconds.
+    uint64_t stall_nanoseconds{};
+};
+
+/// \brief A `ZeroCopyInputStream` filled by a background thread.
+///
+/// The thread keeps up to `depth` buffers of `buffer_size` bytes filled
+/// ahead of the parser. Buffers cycle between the threads through a pair of
+/// lock-free single-producer single-consumer queues, so no memory is
+/// allocated after construction. Errors raised by the source are rethrown
+/// on the parser's thread once it reaches them.
+class ReadAheadInputStream final : public ZeroCopyInputStream
+{
+public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 4 << 20;
+    static constexpr size_t DEFAULT_DEPTH = 4;
+
+    explicit ReadAheadInputStream(
+        std::unique_ptr<Source> source,
+        size_t buffer_size = DEFAULT_BUFFER_SIZE,
+        size_t depth = DEFAULT_DEPTH);
+    ~ReadAheadInputStream() override;
+
+    bool Next(const void** data, int* size) override;
+    void BackUp(int count) override;
+    bool Skip(int count) override;
+    [[nodiscard]] int64_t ByteCount() const override;
+
+    [[nodiscard]] Statistics statistics() const;
+
+private:
+    struct Buffer
+    {
+        std::unique_ptr<char[]> data;
+        size_t size{0};
+    };
+
+    void produce();
+    bool acquire();
+
+    std::unique_ptr<Source> _source;
+    size_t _buffer_size;
+    size_t _depth;
+
+    Queue<Buffer> _full;
+    Queue<Buffer> _free;
+    std::atomic<bool> _stopping{false};
+    std::exception_ptr _error;
+    std::thread _thread;
+
+    // Consumer side only
+    Buffer _current;
+    size_t _position{0};
+    size_t _last_size{0};
+    bool _finished{false};
+    int64_t _byte_count{0};
+    uint64_t _stalls{0};
+    uint64_t _stall_nanoseconds{0};
+};
+
+}
@@ -51,4 +51,57 @@ void Header::deserialize(CodedInputStream& stream)
     stream.ReadLittleEndian32(&this->sign_on_size);
 }
 
-}
\ No newline at end of file
+bool FrameHeader::deserialize(CodedInputStream& stream)
+{
+    if (!stream.ReadRaw(&this->command, 1))
+    {
+        return false;
+    }
+
+    OK(stream.ReadLittleEndian32(&this->tick));
+    OK(stream.Skip(1));  // player slot
+
+    this->sequence = 0;
+    this->size = 0;
+    switch (this->command)
+    {
+        case Command::SIGN_ON:
+        case Command::PACKET:
+            OK(stream.Skip(PACKET_INFO_SIZE));
+            OK(stream.ReadLittleEndian32(&this->size));
+            break;
+        case Command::USER_COMMAND:
+            OK(stream.ReadLittleEndian32(&this->sequence));
+            OK(stream.ReadLittleEndian32(&this->size));
+            break;
+        case Command::CONSOLE_COMMAND:
+        case Command::DATA_TABLES:
+        case Command::STRING_TABLES:
+            OK(stream.ReadLittleEndian32(&this->size));
+            break;
+        default:
+            break;
+    }
+
+    return true;
+}
+
+bool FrameHeader::sized(Command::Type command)
+{
+    switch (command)
+    {
+        case Command::SIGN_ON:
+        case Command::PACKET:
+        case Command::SYNC_TICK:
+        case Command::CONSOLE_COMMAND:
+        case Command::USER_COMMAND:
+        case Command::DATA_TABLES:
+        case Command::STOP:
+        case Command::STRING_TABLES:
+            return true;
+        default:
+            return false;
+    }
+}
+
+}
@@ -53,6 +53,32 @@ struct Command
     };
 };
 
+/// Arbitrary player data preceding the payload of `SIGN_ON` and `PACKET` frames
+constexpr uint32_t PACKET_INFO_SIZE = 152 + 4 + 4;
+
+/// \brief The fields of a frame that precede its payload.
+struct FrameHeader
+{
+    Command::Type command{};
+    uint32_t tick{};
+    /// The outgoing sequence of `USER_COMMAND` frames.
+    uint32_t sequence{};
+    /// Size of the length-prefixed payload, zero for frames without one.
+    uint32_t size{};
+
+    /// \brief Read a frame up to its payload, skipping packet info.
+    ///
+    /// Frames that aren't `sized` are only read up to the player slot.
+    ///
+    /// \return false at a clean end of input.
+    /// \throws GameError if the frame is truncated.
+    bool deserialize(CodedInputStream& stream);
+
+    /// \brief Whether frames with the command can be read past, unlike
+    ///     `CUSTOM_DATA` and unknown frames.
+    static bool sized(Command::Type command);
+};
+
 LOOKUP(describe_command, Command::Type, const char*,
     CASE(Command::SIGN_ON, "SIGN_ON")
     CASE(Command::PACKET, "PACKET")
@@ -0,0 +1,194 @@
+#include "frame_index.h"
+#include "../file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace csgopp::demo::frame_index
+{
+
+using csgopp::demo::FrameHeader;
+using csgopp::demo::Header;
+using csgopp::demo::PACKET_INFO_SIZE;
+
+// Command byte, tick and player slot
+constexpr uint64_t FRAME_PREFIX_SIZE = 1 + 4 + 1;
+
+// Per-record bytes in the sidecar: offset, tick, size, command
+constexpr size_t RECORD_SIZE = 8 + 4 + 4 + 1;
+
+uint64_t Frame::payload() const
+{
+    uint64_t position = this->offset + FRAME_PREFIX_SIZE;
+    switch (this->command)
+    {
+        case Command::SIGN_ON:
+        case Command::PACKET:
+            return position + PACKET_INFO_SIZE + 4;
+        case Command::USER_COMMAND:
+            return position + 4 + 4;
+        case Command::CONSOLE_COMMAND:
+        case Command::DATA_TABLES:
+        case Command::STRING_TABLES:
+            return position + 4;
+        default:
+            return position;
+    }
+}
+
+FrameIndex FrameIndex::scan(CodedInputStream& stream)
+{
+    FrameIndex index;
+    while (true)
+    {
+        Frame frame;
+        frame.offset = static_cast<uint64_t>(stream.CurrentPosition());
+
+        // A demo without a STOP frame simply ends
+        FrameHeader header;
+        if (!header.deserialize(stream))
+        {
+            break;
+        }
+
+        if (!FrameHeader::sized(header.command))
+        {
+            throw GameError("cannot index command " + std::to_string(header.command));
+        }
+
+        frame.command = header.command;
+        frame.tick = header.tick;
+        frame.size = header.size;
+        OK(stream.Skip(static_cast<int>(frame.size)));
+        index._frames.push_back(frame);
+
+        if (frame.command == Command::STOP)
+        {
+            break;
+        }
+    }
+
+    return index;
+}
+
+FrameIndex FrameIndex::scan(const std::filesystem::path& demo)
+{
+    std::unique_ptr<google::protobuf::io::ZeroCopyInputStream> input = csgopp::file::open(demo);
+    CodedInputStream stream(input.get());
+    Header header(stream);
+    return FrameIndex::scan(stream);
+}
+
+std::filesystem::path FrameIndex::sidecar(const std::filesystem::path& demo)
+{
+    std::filesystem::path path(demo);
+    path += ".index";
+    return path;
+}
+
+template<typename T>
+static void write_value(char*& cursor, T value)
+{
+    std::memcpy(cursor, &value, sizeof(T));
+    cursor += sizeof(T);
+}
+
+template<typename T>
+static T read_value(const char*& cursor)
+{
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+void FrameIndex::save(const std::filesystem::path& path) const
+{
+    std::vector<char> buffer(sizeof(MAGIC) + 4 + 8 + RECORD_SIZE * this->_frames.size());
+    char* cursor = buffer.data();
+
+    std::memcpy(cursor, MAGIC, sizeof(MAGIC));
+    cursor += sizeof(MAGIC);
+    write_value<uint32_t>(cursor, VERSION);
+    write_value<uint64_t>(cursor, this->_frames.size());
+    for (const Frame& frame : this->_frames)
+    {
+        write_value<uint64_t>(cursor, frame.offset);
+        write_value<uint32_t>(cursor, frame.tick);
+        write_value<uint32_t>(cursor, frame.size);
+        write_value<Command::Type>(cursor, frame.command);
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!out)
+    {
+        throw FrameIndexError("failed to write " + path.string());
+    }
+}
+
+FrameIndex FrameIndex::load(const std::filesystem::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        throw FrameIndexError("failed to open " + path.string());
+    }
+
+    std::vector<char> buffer((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const char* cursor = buffer.data();
+    const char* end = buffer.data() + buffer.size();
+
+    constexpr size_t HEADER_SIZE = sizeof(MAGIC) + 4 + 8;
+    if (buffer.size() < HEADER_SIZE || std::memcmp(cursor, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw FrameIndexError("not a frame index: " + path.string());
+    }
+
+    cursor += sizeof(MAGIC);
+    uint32_t version = read_value<uint32_t>(cursor);
+    if (version != VERSION)
+    {
+        throw FrameIndexError("unsupported frame index version " + std::to_string(version));
+    }
+
+    uint64_t count = read_value<uint64_t>(cursor);
+    if (static_cast<uint64_t>(end - cursor) != count * RECORD_SIZE)
+    {
+        throw FrameIndexError("truncated frame index: " + path.string());
+    }
+
+    FrameIndex index;
+    index._frames.resize(count);
+    for (Frame& frame : index._frames)
+    {
+        frame.offset = read_value<uint64_t>(cursor);
+        frame.tick = read_value<uint32_t>(cursor);
+        frame.size = read_value<uint32_t>(cursor);
+        frame.command = read_value<Command::Type>(cursor);
+    }
+
+    return index;
+}
+
+const Frame* FrameIndex::find(Command::Type command) const
+{
+    auto iterator = std::find_if(
+        this->_frames.begin(),
+        this->_frames.end(),
+        [command](const Frame& frame) { return frame.command == command; });
+    return iterator != this->_frames.end() ? &*iterator : nullptr;
+}
+
+std::vector<Frame>::const_iterator FrameIndex::at(uint32_t tick) const
+{
+    return std::lower_bound(
+        this->_frames.begin(),
+        this->_frames.end(),
+        tick,
+        [](const Frame& frame, uint32_t tick) { return frame.tick < tick; });
+}
+
+}
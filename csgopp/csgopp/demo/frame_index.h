@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+#include <google/protobuf/io/coded_stream.h>
+
+#include "../demo.h"
+#include "../error.h"
+
+/// A compact table of where each frame of a demo lives on disk.
+///
+/// Building an index only reads the fixed command, tick and size fields of
+/// each frame and skips every payload, so it is bounded by I/O rather than
+/// by parsing. Tools can then jump straight to a frame (for example the
+/// `DATA_TABLES` frame or the last few minutes of play) without decoding
+/// everything that precedes it.
+namespace csgopp::demo::frame_index
+{
+
+using google::protobuf::io::CodedInputStream;
+using csgopp::demo::Command;
+
+class FrameIndexError : public csgopp::error::Error
+{
+    using Error::Error;
+};
+
+/// \brief The location and shape of a single frame.
+struct Frame
+{
+    /// Byte offset of the frame's command byte from the start of the demo.
+    uint64_t offset{};
+    uint32_t tick{};
+    /// Size of the length-prefixed payload, zero for frames without one.
+    uint32_t size{};
+    Command::Type command{};
+
+    /// \brief The byte offset of the payload following its size prefix.
+    [[nodiscard]] uint64_t payload() const;
+};
+
+class FrameIndex
+{
+public:
+    static constexpr char MAGIC[8] = {'C', 'S', 'G', 'O', 'P', 'P', 'F', 'I'};
+    static constexpr uint32_t VERSION = 1;
+
+    FrameIndex() = default;
+
+    /// \brief Scan the frames remaining in a stream.
+    ///
+    /// The stream must be positioned at the first frame, i.e. immediately
+    /// after the `Header`. Offsets are taken from the stream's current
+    /// position, so it should have been constructed at the start of the
+    /// demo. Scanning ends after the `STOP` frame or at a clean end of input.
+    ///
+    /// \param stream the demo stream positioned after the header.
+    /// \return the index of every frame that was read.
+    static FrameIndex scan(CodedInputStream& stream);
+
+    /// \brief Open a demo with `csgopp::file::open` and scan all of its frames.
+    ///
+    /// Offsets into compressed demos refer to the decompressed stream.
+    static FrameIndex scan(const std::filesystem::path& demo);
+
+    /// \brief The conventional sidecar location for a demo's index.
+    static std::filesystem::path sidecar(const std::filesystem::path& demo);
+
+    /// \brief Write the index in its compact binary form.
+    void save(const std::filesystem::path& path) const;
+
+    /// \brief Read an index previously written by `save`.
+    static FrameIndex load(const std::filesystem::path& path);
+
+    [[nodiscard]] const std::vector<Frame>& frames() const { return this->_frames; }
+    [[nodiscard]] size_t size() const { return this->_frames.size(); }
+    [[nodiscard]] bool empty() const { return this->_frames.empty(); }
+
+    /// \brief Get the first frame with the given command, if any.
+    [[nodiscard]] const Frame* find(Command::Type command) const;
+
+    /// \brief Get the first frame at or after the given tick.
+    ///
+    /// Ticks are non-decreasing through a demo, so this is a binary search.
+    /// Returns `frames().end()` if the tick is past the end of the demo.
+    [[nodiscard]] std::vector<Frame>::const_iterator at(uint32_t tick) const;
+
+private:
+    std::vector<Frame> _frames;
+};
+
+}
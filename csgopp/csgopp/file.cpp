@@ -0,0 +1,30 @@
+#include "file.h"
+#include "common/compression.h"
+#include "common/memory_map.h"
+#include "common/read_ahead.h"
+
+namespace csgopp::file
+{
+
+using csgopp::common::compression::Format;
+using csgopp::common::compression::decompress;
+using csgopp::common::compression::detect;
+using csgopp::common::memory_map::MemoryMappedInputStream;
+using csgopp::common::read_ahead::FileSource;
+
+std::unique_ptr<ZeroCopyInputStream> open(const std::filesystem::path& path, const Options& options)
+{
+    // Compressed demos are always decompressed on the read-ahead thread
+    Format format = detect(path);
+    if (options.read_ahead || format != Format::NONE)
+    {
+        return std::make_unique<ReadAheadInputStream>(
+            decompress(std::make_unique<FileSource>(path), format),
+            options.buffer_size,
+            options.depth);
+    }
+
+    return std::make_unique<MemoryMappedInputStream>(path);
+}
+
+}
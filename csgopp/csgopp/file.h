@@ -0,0 +1,213 @@
+#pragma once
+
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream.h>
+
+#include "client.h"
+#include "demo.h"
+#include "common/read_ahead.h"
+
+/// Helpers for reading demos straight from disk.
+namespace csgopp::file
+{
+
+using csgopp::client::Client;
+using csgopp::client::checkpoint::Checkpoint;
+using csgopp::client::pipeline::Frame;
+using csgopp::client::pipeline::Pipeline;
+using csgopp::common::read_ahead::ReadAheadInputStream;
+using csgopp::demo::Header;
+using csgopp::error::GameError;
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::ZeroCopyInputStream;
+
+struct Options
+{
+    /// Read on a background thread rather than memory mapping the file,
+    /// which keeps the parser from faulting on cold storage.
+    bool read_ahead{false};
+    size_t buffer_size{ReadAheadInputStream::DEFAULT_BUFFER_SIZE};
+    size_t depth{ReadAheadInputStream::DEFAULT_DEPTH};
+    /// Split frames and parse entity messages on a separate thread from
+    /// the one applying them, see `csgopp::client::pipeline`.
+    bool pipeline{false};
+    size_t pipeline_depth{Pipeline::DEFAULT_DEPTH};
+};
+
+/// \brief Open a demo file as a zero-copy input stream.
+///
+/// By default the file is memory mapped, so frames are parsed directly out
+/// of the page cache rather than being copied through an `std::ifstream`
+/// buffer. With `Options::read_ahead`, a dedicated thread instead keeps the
+/// next `depth` buffers of the file resident ahead of the parser. Demos
+/// compressed with gzip, zstd or bzip2 are detected by their magic bytes
+/// and always decompressed on the read-ahead thread.
+///
+/// \param path the path of the demo.
+/// \param options how to read the file.
+/// \return an owning pointer to the opened stream.
+std::unique_ptr<ZeroCopyInputStream> open(const std::filesystem::path& path, const Options& options = {});
+
+/// \brief A client that owns the demo it is reading.
+///
+/// Every entry point used to pack an `std::ifstream`, `IstreamInputStream`
+/// and `CodedInputStream` next to its client; this does the same thing once
+/// using `open`. The header is read on construction.
+///
+/// \tparam T the client (usually a subclass with observer overrides).
+template<typename T = Client>
+class FileClient : public T
+{
+public:
+    using T::advance;
+
+    template<typename... Args>
+    requires (!std::is_same_v<std::remove_cvref_t<Args>, Options> && ...)
+    explicit FileClient(std::filesystem::path path, Args&&... args)
+        : FileClient(std::move(path), Options(), std::forward<Args>(args)...)
+    {
+    }
+
+    template<typename... Args>
+    FileClient(std::filesystem::path path, const Options& options, Args&&... args)
+        : T(std::forward<Args>(args)...)
+        , _path(std::move(path))
+        , _options(options)
+        , _input(open(this->_path, this->_options))
+        , _stream(std::make_unique<CodedInputStream>(this->_input.get()))
+    {
+        this->_header = Header(*this->_stream);
+    }
+
+    /// \brief Advance a single frame from the owned stream.
+    ///
+    /// A pipeline is started on the first advance after opening or jumping,
+    /// so it reads with the packet filter the client has been configured
+    /// with by then.
+    bool advance()
+    {
+        if (this->_options.pipeline && this->_pipeline == nullptr)
+        {
+            this->start_pipeline();
+        }
+
+        if (this->_pipeline != nullptr)
+        {
+            Frame* frame = this->_pipeline->next();
+            if (frame == nullptr)
+            {
+                return false;
+            }
+            this->_position = frame->end;
+            return T::advance(*frame);
+        }
+
+        return T::advance(*this->_stream);
+    }
+
+    /// \brief Change how the demo is read, keeping the current position.
+    void configure(const Options& options)
+    {
+        int64_t position = this->position();
+        this->_options = options;
+        this->jump(position);
+    }
+
+    /// \brief The byte offset of the next frame the client will apply.
+    ///
+    /// With a pipeline the stream itself is read further ahead.
+    [[nodiscard]] int64_t position() const
+    {
+        return this->_pipeline != nullptr ? this->_position : this->_stream->CurrentPosition();
+    }
+
+    /// \brief Reposition the stream at a frame boundary.
+    ///
+    /// The demo is reopened and the stream skips forward to the offset,
+    /// which should come from a `FrameIndex`. Client state is untouched, so
+    /// the caller is responsible for only jumping where that makes sense.
+    /// Stream positions are `int`s, so offsets past 2 GiB throw a
+    /// `GameError` and leave the stream where it was.
+    ///
+    /// \param offset the byte offset of a frame from the start of the demo.
+    void jump(uint64_t offset)
+    {
+        if (offset > static_cast<uint64_t>(std::numeric_limits<int>::max()))
+        {
+            throw GameError("offset " + std::to_string(offset) + " is out of range of the stream");
+        }
+
+        this->_pipeline.reset();
+        this->_stream.reset();
+        this->_input = open(this->_path, this->_options);
+        this->_stream = std::make_unique<CodedInputStream>(this->_input.get());
+        OK(this->_stream->Skip(static_cast<int>(offset)));
+    }
+
+    /// \brief Bring the client to the first frame at or after a tick.
+    ///
+    /// If a checkpoint at or before the tick is closer than the current
+    /// position, it is restored and only the remaining frames are replayed.
+    /// Checkpoints loaded from elsewhere need the schema, so a fresh client
+    /// first advances until its data tables have been read. Seeking
+    /// backwards is only possible when such a checkpoint exists.
+    ///
+    /// \param tick the tick to seek to.
+    /// \return whether there are frames remaining.
+    bool seek(uint32_t tick)
+    {
+        const Checkpoint* checkpoint = this->_checkpoints.before(tick);
+        if (checkpoint != nullptr && (tick < this->_tick || checkpoint->tick > this->_tick))
+        {
+            // Advancing may record checkpoints, so look it up again after
+            if (this->_server_classes.size() == 0)
+            {
+                while (this->_server_classes.size() == 0 && this->advance());
+                checkpoint = this->_checkpoints.before(tick);
+            }
+
+            this->restore(*checkpoint);
+            this->jump(checkpoint->offset);
+        }
+        else if (tick < this->_tick)
+        {
+            throw GameError("no checkpoint to seek back to tick " + std::to_string(tick));
+        }
+
+        bool ok = true;
+        while (ok && this->_tick < tick)
+        {
+            ok = this->advance();
+        }
+        return ok;
+    }
+
+    [[nodiscard]] const std::filesystem::path& path() const { return this->_path; }
+    /// Owned by the pipeline's reader thread while there is one
+    [[nodiscard]] CodedInputStream& stream() { return *this->_stream; }
+    [[nodiscard]] ZeroCopyInputStream& input() { return *this->_input; }
+    [[nodiscard]] const Options& options() const { return this->_options; }
+    [[nodiscard]] const Pipeline* pipeline() const { return this->_pipeline.get(); }
+
+protected:
+    std::filesystem::path _path;
+    Options _options;
+    std::unique_ptr<ZeroCopyInputStream> _input;
+    std::unique_ptr<CodedInputStream> _stream;
+    /// Declared after the stream it reads so it is destroyed first
+    std::unique_ptr<Pipeline> _pipeline;
+    int64_t _position{0};
+
+    void start_pipeline()
+    {
+        this->_position = this->_stream->CurrentPosition();
+        this->_pipeline = std::make_unique<Pipeline>(*this->_stream, this->packet_filter(), this->_options.pipeline_depth);
+    }
+};
+
+}
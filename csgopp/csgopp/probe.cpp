@@ -0,0 +1,113 @@
+#include "probe.h"
+
+namespace csgopp::probe
+{
+
+static void skip_length_prefixed(CodedInputStream& stream)
+{
+    uint32_t size;
+    OK(stream.ReadVarint32(&size));
+    OK(stream.Skip(static_cast<int32_t>(size)));
+}
+
+ProbeClient::ProbeClient()
+{
+    this->set_events_only(true);
+}
+
+ProbeClient::ProbeClient(CodedInputStream& stream) : Client(stream)
+{
+    this->set_events_only(true);
+}
+
+void ProbeClient::probe(CodedInputStream& stream)
+{
+    int start = stream.CurrentPosition();
+    uint32_t sign_on_size = this->_header.sign_on_size;
+    while (!this->_synchronized)
+    {
+        this->_bytes = stream.CurrentPosition() - start;
+        if (sign_on_size > 0 && this->_bytes >= sign_on_size)
+        {
+            break;
+        }
+        if (!this->advance(stream))
+        {
+            break;
+        }
+    }
+    this->_bytes = stream.CurrentPosition() - start;
+}
+
+Probe ProbeClient::result() const
+{
+    Probe probe;
+    probe.header = this->_header;
+    probe.has_server_info = this->_has_server_info;
+    probe.server_info = this->_server_info;
+    for (const std::shared_ptr<User>& user : this->_users)
+    {
+        if (user != nullptr)
+        {
+            probe.users.emplace_back(user);
+        }
+    }
+    for (const std::shared_ptr<GameEventType>& game_event_type : this->_game_event_types)
+    {
+        if (game_event_type != nullptr)
+        {
+            probe.game_event_types.emplace_back(game_event_type);
+        }
+    }
+    probe.frames = this->_cursor;
+    probe.bytes = this->_bytes;
+    return probe;
+}
+
+void ProbeClient::advance_data_tables(CodedInputStream& stream)
+{
+    uint32_t size;
+    VERIFY(stream.ReadLittleEndian32(&size));
+    VERIFY(stream.Skip(static_cast<int>(size)));
+}
+
+void ProbeClient::advance_packet_server_info(CodedInputStream& stream)
+{
+    CodedInputStream::Limit limit = stream.ReadLengthAndPushLimit();
+    VERIFY(this->_server_info.ParseFromCodedStream(&stream));
+    VERIFY(stream.BytesUntilLimit() == 0);
+    stream.PopLimit(limit);
+    this->_has_server_info = true;
+}
+
+void ProbeClient::advance_packet_send_table(CodedInputStream& stream)
+{
+    skip_length_prefixed(stream);
+}
+
+void ProbeClient::on_frame(csgopp::demo::Command::Type command)
+{
+    if (command == csgopp::demo::Command::SYNC_TICK)
+    {
+        this->_synchronized = true;
+    }
+}
+
+Probe probe(CodedInputStream& stream)
+{
+    ProbeClient client(stream);
+    client.probe(stream);
+    return client.result();
+}
+
+Probe probe(const std::filesystem::path& path, const csgopp::file::Options& options)
+{
+    // Probing reads the stream directly, so it can't share it with a pipeline
+    csgopp::file::Options unpipelined = options;
+    unpipelined.pipeline = false;
+    csgopp::file::FileClient<ProbeClient> client(path, unpipelined);
+    client.probe(client.stream());
+    return client.result();
+}
+
+}
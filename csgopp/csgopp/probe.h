@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "client.h"
+#include "demo.h"
+#include "file.h"
+
+/// Reading catalog metadata without parsing a whole demo.
+///
+/// A probe reads the header and then only the sign-on section of the demo,
+/// which is where the server announces its info, the game event list and
+/// the initial `userinfo` table. Data tables are skipped without building
+/// any types and no entity is ever decoded, so a probe costs a few
+/// milliseconds regardless of the demo's length.
+namespace csgopp::probe
+{
+
+using csgo::message::net::CSVCMsg_ServerInfo;
+using csgopp::client::Client;
+using csgopp::client::GameEventType;
+using csgopp::client::User;
+using csgopp::demo::Header;
+using google::protobuf::io::CodedInputStream;
+
+/// \brief The metadata gathered by a probe.
+struct Probe
+{
+    Header header;
+    bool has_server_info{false};
+    CSVCMsg_ServerInfo server_info;
+    /// Users present at sign-on; players who connect later are not listed.
+    std::vector<std::shared_ptr<const User>> users;
+    std::vector<std::shared_ptr<const GameEventType>> game_event_types;
+    uint32_t frames{};
+    /// Bytes read past the header, at least `header.sign_on_size`.
+    uint64_t bytes{};
+};
+
+/// \brief A client that stops at the end of the sign-on section.
+///
+/// It runs in events-only mode, skips the data tables and `svc_SendTable`
+/// without constructing their types, and captures `svc_ServerInfo`.
+class ProbeClient : public Client
+{
+public:
+    explicit ProbeClient();
+    explicit ProbeClient(CodedInputStream& stream);
+
+    /// \brief Advance until the sign-on section has been consumed.
+    ///
+    /// The stream must be positioned immediately after the header. Demos
+    /// without a sign-on size stop at the first `SYNC_TICK` instead.
+    void probe(CodedInputStream& stream);
+
+    /// \brief Collect what has been parsed so far.
+    [[nodiscard]] Probe result() const;
+
+    void advance_data_tables(CodedInputStream& stream) override;
+    void advance_packet_server_info(CodedInputStream& stream) override;
+    void advance_packet_send_table(CodedInputStream& stream) override;
+    void on_frame(csgopp::demo::Command::Type command) override;
+
+protected:
+    bool _has_server_info{false};
+    CSVCMsg_ServerInfo _server_info;
+    bool _synchronized{false};
+    uint64_t _bytes{0};
+};
+
+/// \brief Read a demo's header from the stream and probe it.
+Probe probe(CodedInputStream& stream);
+
+/// \brief Open a demo and probe it.
+///
+/// `Options::pipeline` is ignored since the probe reads the stream itself.
+Probe probe(const std::filesystem::path& path, const csgopp::file::Options& options = {});
+
+}
@@ -1,7 +1,6 @@
 #include <memory>
 #include <utility>
 #include <iostream>
-#include <fstream>
 #include <typeindex>
 #include <absl/container/flat_hash_map.h>
 
@@ -14,6 +13,7 @@
 #include <google/protobuf/io/coded_stream.h>
 
 #include <csgopp/client.h>
+#include <csgopp/file.h>
 
 using namespace nanobind::literals;
 
@@ -32,8 +32,8 @@ using csgopp::client::User;
 using csgopp::common::vector::Vector2;
 using csgopp::common::vector::Vector3;
 using csgopp::demo::Header;
+using csgopp::file::FileClient;
 using google::protobuf::io::CodedInputStream;
-using google::protobuf::io::IstreamInputStream;
 using object::ConstReference;
 using object::Lens;
 using object::IndexError;
@@ -366,20 +366,10 @@ struct EntityAdapter : public Adapter<const Entity>
         nb_trampoline.base().attr(nb_key)(__VA_ARGS__);                        \
     }
 
-struct ClientAdapter : public Client
+struct ClientAdapter : public FileClient<Client>
 {
-    // Pack this in here since it's opaque in Python
-    std::ifstream file_stream;
-    IstreamInputStream file_input_stream;
-    CodedInputStream coded_input_stream;
-
-    explicit ClientAdapter(auto path)
-        : file_input_stream(&this->file_stream)
-        , coded_input_stream(&this->file_input_stream)
-    {
-        this->file_stream.open(path, std::ios::binary);
-        this->_header = csgopp::demo::Header(this->coded_input_stream);
-    }
+    // The stream is owned by the file client since it's opaque in Python
+    using FileClient::FileClient;
 
     /// Inheritance compatibility bindings
     [[maybe_unused]] void on_data_table_creation(const DataTableAdapter&) {}
@@ -400,12 +390,12 @@ struct ClientAdapter : public Client
 
     bool advance()
     {
-        return Client::advance(this->coded_input_stream);
+        return FileClient::advance();
     }
 
     void parse()
     {
-        while (Client::advance(coded_input_stream));
+        while (FileClient::advance());
     }
 };
 
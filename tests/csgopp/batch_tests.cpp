@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/batch.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace csgopp::batch;
+
+TEST(Batch, collect_manifest)
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "csgopp_batch_collect";
+    std::filesystem::create_directories(directory);
+    {
+        std::ofstream manifest(directory / "manifest.txt");
+        manifest << "# comment\n" << "first.dem\n" << "\n" << "/absolute/second.dem\r\n";
+    }
+
+    std::vector<std::filesystem::path> paths = collect(directory / "manifest.txt");
+    ASSERT_EQ(paths.size(), 2);
+    EXPECT_EQ(paths[0], directory / "first.dem");
+    EXPECT_EQ(paths[1], std::filesystem::path("/absolute/second.dem"));
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(Batch, errors)
+{
+    std::vector<std::filesystem::path> paths{"csgopp_batch_missing_1.dem", "csgopp_batch_missing_2.dem"};
+    Options options;
+    options.threads = 2;
+    options.memory = 1 << 20;
+
+    Report report = run(paths, options);
+    ASSERT_EQ(report.results.size(), 2);
+    EXPECT_EQ(report.failed(), 2);
+    EXPECT_FALSE(report.results[0].error.empty());
+    EXPECT_EQ(report.results[1].path, paths[1]);
+}
+
+TEST(Batch, unknown_errors)
+{
+    std::vector<std::filesystem::path> paths{"first.dem", "second.dem", "third.dem"};
+    Options options;
+    options.threads = 2;
+    options.memory = 1 << 20;
+    options.demo_cost = 1 << 20;
+
+    // Each demo takes the whole budget, so a leaked reservation would hang
+    Report report = schedule(paths, options, [](const std::filesystem::path& path, Result& result)
+    {
+        if (path == "second.dem")
+        {
+            throw 42;
+        }
+    });
+    ASSERT_EQ(report.results.size(), 3);
+    EXPECT_EQ(report.succeeded(), 2);
+    EXPECT_FALSE(report.results[1].ok);
+    EXPECT_EQ(report.results[1].error, "unknown error");
+}
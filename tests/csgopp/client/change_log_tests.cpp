@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/client/change_log.h>
+#include <csgopp/common/vector.h>
+
+#include <array>
+#include <filesystem>
+
+#include "player_table.h"
+
+using namespace csgopp::client::change_log;
+using csgopp::client::data_table::DataTable;
+using csgopp::client::data_table::property::Property;
+using csgopp::client::server_class::ServerClass;
+using csgopp::common::vector::Vector3;
+using player_table::make_server_class;
+using player_table::make_weapon_server_class;
+using player_table::prioritized_index;
+
+/// Two players whose health and position change over a few ticks
+static ChangeLog make_change_log()
+{
+    std::shared_ptr<ServerClass> server_class = make_server_class();
+    std::shared_ptr<const EntityType> type = server_class->data_table->type();
+    uint16_t health = prioritized_index(*type, "m_iHealth");
+    uint16_t origin = prioritized_index(*type, "m_vecOrigin");
+    uint16_t name = prioritized_index(*type, "m_szName");
+
+    ChangeLog log;
+    Entity first(std::shared_ptr<const EntityType>(type), 1, server_class);
+    first["m_iHealth"].is<int32_t>() = 100;
+    first["m_szName"].is<std::string>() = "alice";
+    log.assign(10, first);
+
+    Entity second(std::shared_ptr<const EntityType>(type), 2, server_class);
+    second["m_iHealth"].is<int32_t>() = 100;
+    second["m_szName"].is<std::string>() = "bob";
+    log.assign(10, second);
+
+    first["m_iHealth"].is<int32_t>() = 73;
+    first["m_vecOrigin"].is<Vector3>().x = 5;
+    log.update(12, first, {health, origin});
+    second["m_iHealth"].is<int32_t>() = -2;
+    log.update(12, second, {health});
+    first["m_vecOrigin"].is<Vector3>().x = 0;
+    first["m_szName"].is<std::string>() = "bob";
+    log.update(15, first, {origin, name});
+
+    return log;
+}
+
+TEST(ChangeLog, series)
+{
+    ChangeLog log = make_change_log();
+    EXPECT_EQ(log.size(), 11);
+
+    std::vector<Sample<int32_t>> health = log.series<int32_t>("CPlayer", "m_iHealth");
+    ASSERT_EQ(health.size(), 4);
+    EXPECT_EQ(health[0].tick, 10);
+    EXPECT_EQ(health[0].id, 1);
+    EXPECT_EQ(health[0].value, 100);
+    EXPECT_EQ(health[2].tick, 12);
+    EXPECT_EQ(health[2].value, 73);
+    EXPECT_EQ(health[3].id, 2);
+    EXPECT_EQ(health[3].value, -2);
+
+    std::vector<Sample<Vector3>> origin = log.series<Vector3>("CPlayer", "m_vecOrigin", 1);
+    ASSERT_EQ(origin.size(), 3);
+    EXPECT_EQ(origin[1].value.x, 5);
+    EXPECT_EQ(origin[2].tick, 15);
+    EXPECT_EQ(origin[2].value.x, 0);
+
+    std::vector<Sample<std::string>> names = log.series<std::string>("CPlayer", "m_szName");
+    ASSERT_EQ(names.size(), 3);
+    EXPECT_EQ(names[0].value, "alice");
+    EXPECT_EQ(names[1].value, "bob");
+    EXPECT_EQ(names[2].value, "bob");
+
+    EXPECT_TRUE(log.series<int32_t>("CPlayer", "m_iArmor").empty());
+    EXPECT_THROW((void)log.series<float>("CPlayer", "m_iHealth"), ChangeLogError);
+    EXPECT_THROW((void)log.series<int32_t>("CPlayer", "m_szName"), ChangeLogError);
+}
+
+TEST(ChangeLog, encoding)
+{
+    ChangeLog log = make_change_log();
+
+    // Vectors keep no dictionary, and unchanged components take a byte
+    const Track* origin = log.find("CPlayer", "m_vecOrigin");
+    ASSERT_NE(origin, nullptr);
+    EXPECT_EQ(origin->encoding, Track::Encoding::XOR);
+    EXPECT_TRUE(origin->codes.empty());
+    EXPECT_LT(origin->records.size(), 4 * sizeof(Vector3));
+
+    // Repeated values are referred to by dictionary code
+    const Track* name = log.find("CPlayer", "m_szName");
+    ASSERT_NE(name, nullptr);
+    EXPECT_EQ(name->encoding, Track::Encoding::DICTIONARY);
+    EXPECT_EQ(name->codes.size(), 2);
+
+    const Track* health = log.find("CPlayer", "m_iHealth");
+    ASSERT_NE(health, nullptr);
+    EXPECT_EQ(health->encoding, Track::Encoding::DELTA);
+    EXPECT_LT(health->records.size(), 4 * (sizeof(uint32_t) + sizeof(uint16_t) + sizeof(int32_t)));
+}
+
+TEST(ChangeLog, dictionary_size)
+{
+    std::shared_ptr<ServerClass> server_class = make_server_class();
+    std::shared_ptr<const EntityType> type = server_class->data_table->type();
+    uint16_t name = prioritized_index(*type, "m_szName");
+
+    ChangeLog log(2);
+    Entity entity(std::shared_ptr<const EntityType>(type), 0, server_class);
+    for (uint32_t tick = 0; tick < 6; ++tick)
+    {
+        entity["m_szName"].is<std::string>() = std::to_string(tick % 3);
+        log.update(tick, entity, {name});
+    }
+
+    EXPECT_EQ(log.find("CPlayer", "m_szName")->codes.size(), 2);
+    std::vector<Sample<std::string>> samples = log.series<std::string>("CPlayer", "m_szName");
+    ASSERT_EQ(samples.size(), 6);
+    for (uint32_t tick = 0; tick < 6; ++tick)
+    {
+        EXPECT_EQ(samples[tick].tick, tick);
+        EXPECT_EQ(samples[tick].value, std::to_string(tick % 3));
+    }
+}
+
+TEST(ChangeLog, xor)
+{
+    std::shared_ptr<ServerClass> server_class = make_server_class();
+    std::shared_ptr<const EntityType> type = server_class->data_table->type();
+    uint16_t origin = prioritized_index(*type, "m_vecOrigin");
+
+    // Two entities moving independently, never repeating a position
+    ChangeLog log;
+    Entity first(std::shared_ptr<const EntityType>(type), 3, server_class);
+    Entity second(std::shared_ptr<const EntityType>(type), 7, server_class);
+    for (uint32_t tick = 0; tick < 100; ++tick)
+    {
+        Vector3& position = first["m_vecOrigin"].is<Vector3>();
+        position.x = 1024.0f + static_cast<float>(tick) * 0.25f;
+        position.y = -512.5f;
+        log.update(tick, first, {origin});
+        second["m_vecOrigin"].is<Vector3>().z = -static_cast<float>(tick) * 3.0f;
+        log.update(tick, second, {origin});
+    }
+
+    const Track* track = log.find("CPlayer", "m_vecOrigin");
+    ASSERT_NE(track, nullptr);
+    EXPECT_TRUE(track->codes.empty());
+    EXPECT_LT(track->records.size(), 200 * sizeof(Vector3));
+
+    std::vector<Sample<Vector3>> samples = log.series<Vector3>("CPlayer", "m_vecOrigin", 3);
+    ASSERT_EQ(samples.size(), 100);
+    for (uint32_t tick = 0; tick < 100; ++tick)
+    {
+        EXPECT_EQ(samples[tick].value.x, 1024.0f + static_cast<float>(tick) * 0.25f);
+        EXPECT_EQ(samples[tick].value.y, -512.5f);
+    }
+    samples = log.series<Vector3>("CPlayer", "m_vecOrigin", 7);
+    ASSERT_EQ(samples.size(), 100);
+    EXPECT_EQ(samples[99].value.z, -297.0f);
+    EXPECT_EQ(samples[99].value.x, 0.0f);
+}
+
+TEST(ChangeLog, integer_array)
+{
+    std::shared_ptr<ServerClass> server_class = make_weapon_server_class<DataTable::Int32Property>(Property::Kind::INT32, "m_iAmmo", 4);
+    std::shared_ptr<const EntityType> type = server_class->data_table->type();
+    uint16_t index = prioritized_index(*type, "m_iAmmo");
+
+    // Every state is distinct, but only one element changes at a time
+    using Ammo = std::array<int32_t, 4>;
+    ChangeLog log;
+    Entity entity(std::shared_ptr<const EntityType>(type), 4, server_class);
+    for (uint32_t tick = 0; tick < 100; ++tick)
+    {
+        entity["m_iAmmo"][tick % 4].is<int32_t>() = 30 - static_cast<int32_t>(tick);
+        log.update(tick, entity, {index});
+    }
+
+    const Track* track = log.find("CWeapon", "m_iAmmo");
+    ASSERT_NE(track, nullptr);
+    EXPECT_EQ(track->encoding, Track::Encoding::DELTA);
+    EXPECT_TRUE(track->codes.empty());
+    EXPECT_LT(track->records.size(), 100 * sizeof(Ammo));
+    EXPECT_THROW((void)log.series<int32_t>("CWeapon", "m_iAmmo"), ChangeLogError);
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "csgopp_change_log_array.bin";
+    log.save(path);
+    ChangeLog loaded = ChangeLog::load(path);
+    std::filesystem::remove(path);
+
+    for (const ChangeLog* current : {&log, &loaded})
+    {
+        std::vector<Sample<Ammo>> samples = current->series<Ammo>("CWeapon", "m_iAmmo");
+        ASSERT_EQ(samples.size(), 100);
+        EXPECT_EQ(samples[0].value, (Ammo{30, 0, 0, 0}));
+        EXPECT_EQ(samples[5].value, (Ammo{26, 25, 28, 27}));
+        EXPECT_EQ(samples[99].value, (Ammo{-66, -67, -68, -69}));
+    }
+}
+
+TEST(ChangeLog, save_load)
+{
+    ChangeLog log = make_change_log();
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "csgopp_change_log.bin";
+    log.save(path);
+
+    ChangeLog loaded = ChangeLog::load(path);
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(loaded.size(), log.size());
+    EXPECT_EQ(loaded.bytes(), log.bytes());
+    std::vector<Sample<int32_t>> health = loaded.series<int32_t>("CPlayer", "m_iHealth", 2);
+    ASSERT_EQ(health.size(), 2);
+    EXPECT_EQ(health[1].value, -2);
+    EXPECT_EQ(loaded.series<std::string>("CPlayer", "m_szName")[0].value, "alice");
+    EXPECT_EQ(loaded.series<Vector3>("CPlayer", "m_vecOrigin")[2].value.x, 5);
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/client.h>
+#include <csgopp/client/checkpoint.h>
+#include <csgopp/client/data_table/data_type.h>
+#include <filesystem>
+#include <fstream>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+#include "demo_builder.h"
+
+using namespace csgopp::client::checkpoint;
+using csgopp::client::Client;
+using csgopp::client::data_table::data_type::DataArrayType;
+using csgopp::client::data_table::data_type::SignedInt32Type;
+using csgopp::client::data_table::data_type::StringType;
+using csgopp::demo::Command;
+using google::protobuf::io::ArrayInputStream;
+using google::protobuf::io::CodedInputStream;
+using object::Instance;
+using object::ObjectType;
+using object::shared;
+
+/// A client that has read a single data table with one server class
+static void read_schema(Client& client, const std::string& table)
+{
+    using csgo::message::net::CSVCMsg_SendTable;
+
+    std::string tables;
+    CSVCMsg_SendTable send_table;
+    send_table.set_net_table_name(table);
+    demo_builder::append_send_table(tables, send_table);
+    CSVCMsg_SendTable end;
+    end.set_is_end(true);
+    demo_builder::append_send_table(tables, end);
+    uint16_t count = 1;
+    tables.append(reinterpret_cast<const char*>(&count), 2);
+    demo_builder::append_server_class(tables, 0, "CPlayer", table);
+
+    std::string demo;
+    demo_builder::append_frame(demo, Command::DATA_TABLES, 0, tables);
+    ArrayInputStream input(demo.data(), static_cast<int>(demo.size()));
+    CodedInputStream stream(&input);
+    ASSERT_TRUE(client.advance(stream));
+}
+
+static std::shared_ptr<const ObjectType> make_type()
+{
+    ObjectType::Builder builder;
+    builder.member("number", shared<SignedInt32Type>());
+    builder.member("name", shared<StringType>());
+    builder.member("names", std::make_shared<DataArrayType>(shared<StringType>(), 3));
+    return std::make_shared<ObjectType>(std::move(builder));
+}
+
+TEST(Checkpoint, instance)
+{
+    std::shared_ptr<const ObjectType> type = make_type();
+    Instance<ObjectType> instance(type);
+    instance["number"].is<int32_t>() = -42;
+    instance["name"].is<std::string>() = "hello";
+    instance["names"][2].is<std::string>() = std::string(600, 'x');
+
+    Writer writer;
+    writer.write(*type, instance.address.get());
+
+    Instance<ObjectType> copy(type);
+    Reader reader(writer.data);
+    reader.read(*type, copy.address.get());
+    EXPECT_EQ(reader.position, writer.data.size());
+    EXPECT_EQ(copy["number"].is<int32_t>(), -42);
+    EXPECT_EQ(copy["name"].is<std::string>(), "hello");
+    EXPECT_EQ(copy["names"][0].is<std::string>(), "");
+    EXPECT_EQ(copy["names"][2].is<std::string>(), std::string(600, 'x'));
+
+    Reader truncated(writer.data.substr(0, writer.data.size() - 1));
+    EXPECT_THROW(truncated.read(*type, copy.address.get()), CheckpointError);
+}
+
+TEST(Checkpoint, before)
+{
+    Checkpoints checkpoints;
+    checkpoints.emplace(Checkpoint{128, 10, 2000, "b"});
+    checkpoints.emplace(Checkpoint{64, 5, 1000, "a"});
+    checkpoints.emplace(Checkpoint{192, 15, 3000, "c"});
+
+    EXPECT_EQ(checkpoints.before(63), nullptr);
+    EXPECT_EQ(checkpoints.before(64)->state, "a");
+    EXPECT_EQ(checkpoints.before(191)->state, "b");
+    EXPECT_EQ(checkpoints.before(1000)->state, "c");
+    EXPECT_EQ(checkpoints.bytes(), 3);
+}
+
+TEST(Checkpoint, save_load)
+{
+    Checkpoints checkpoints;
+    checkpoints.emplace(Checkpoint{64, 5, 1000, std::string("a\0b", 3)});
+    checkpoints.emplace(Checkpoint{128, 10, 2000, "state"});
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "csgopp_checkpoint.checkpoints";
+    checkpoints.save(path);
+    Checkpoints loaded = Checkpoints::load(path);
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(loaded.size(), 2);
+    EXPECT_EQ(loaded.before(100)->offset, 1000);
+    EXPECT_EQ(loaded.before(100)->state, std::string("a\0b", 3));
+    EXPECT_EQ(loaded.back().cursor, 10);
+}
+
+TEST(Checkpoint, client)
+{
+    Client client;
+    Checkpoint checkpoint = client.checkpoint(1072);
+    EXPECT_EQ(checkpoint.offset, 1072);
+
+    Client other;
+    other.restore(checkpoint);
+    EXPECT_EQ(other.tick(), 0);
+    EXPECT_EQ(other.entities().size(), 0);
+}
+
+TEST(Checkpoint, client_schema)
+{
+    Client client;
+    read_schema(client, "DT_Player");
+    Checkpoint checkpoint = client.checkpoint(0);
+
+    Client same;
+    read_schema(same, "DT_Player");
+    same.restore(checkpoint);
+
+    // Same number of tables and classes, but not the same tables
+    Client other;
+    read_schema(other, "DT_Weapon");
+    EXPECT_THROW(other.restore(checkpoint), CheckpointError);
+}
+
+TEST(Checkpoint, client_inline_strings)
+{
+    Client client;
+    client.set_inline_strings(true);
+    read_schema(client, "DT_Player");
+    Checkpoint checkpoint = client.checkpoint(0);
+
+    Client other;
+    read_schema(other, "DT_Player");
+    EXPECT_THROW(other.restore(checkpoint), CheckpointError);
+}
+
+TEST(Checkpoint, identity)
+{
+    std::filesystem::path demo = std::filesystem::temp_directory_path() / "csgopp_checkpoint_identity.dem";
+    {
+        std::ofstream out(demo, std::ios::binary);
+        out << "HL2DEMO";
+    }
+
+    Checkpoints checkpoints;
+    checkpoints.set_identity(DemoIdentity::of(demo));
+    checkpoints.emplace(Checkpoint{64, 5, 1000, "a"});
+    std::filesystem::path path = Checkpoints::sidecar(demo);
+    checkpoints.save(path);
+
+    EXPECT_EQ(Checkpoints::load(path, DemoIdentity::of(demo)).size(), 1);
+    {
+        std::ofstream out(demo, std::ios::binary);
+        out << "HL2DEMO!";
+    }
+    EXPECT_THROW(Checkpoints::load(path, DemoIdentity::of(demo)), CheckpointError);
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(demo);
+}
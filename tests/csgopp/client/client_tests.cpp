@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/client.h>
+#include <csgopp/file.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "demo_builder.h"
+
+using csgo::message::net::CSVCMsg_CreateStringTable;
+using csgo::message::net::CSVCMsg_PacketEntities;
+using csgo::message::net::CSVCMsg_SendTable;
+using csgo::message::net::SVC_Messages;
+using csgopp::client::Client;
+using csgopp::client::Entity;
+using csgopp::client::column_store::ColumnStore;
+using csgopp::client::data_table::property::Property;
+using csgopp::demo::Command;
+using csgopp::file::FileClient;
+using demo_builder::append_frame;
+using demo_builder::append_message;
+using demo_builder::append_send_table;
+using demo_builder::append_server_class;
+using demo_builder::BitWriter;
+using google::protobuf::io::ArrayInputStream;
+using google::protobuf::io::CodedInputStream;
+
+/// Changed indices for the first properties with the small increment encoding
+static void write_first_indices(BitWriter& writer, size_t count)
+{
+    writer.write(1, 1);  // small increment optimization
+    for (size_t i = 0; i < count; ++i)
+    {
+        writer.write(1, 1);  // jump of zero
+    }
+    writer.write(0, 2);
+    writer.write(0x3FFF, 14);  // end of indices
+}
+
+static std::string make_packet_entities(const BitWriter& writer, uint32_t count)
+{
+    CSVCMsg_PacketEntities entities;
+    entities.set_max_entries(1);
+    entities.set_updated_entries(count);
+    entities.set_entity_data(writer.data + std::string(8, '\0'));
+
+    std::string packet;
+    append_message(packet, SVC_Messages::svc_PacketEntities, entities);
+    return packet;
+}
+
+/// A demo that creates a single `CPlayer` and then updates its health
+/// but not its armor
+static std::string make_entity_demo()
+{
+    std::string tables;
+    CSVCMsg_SendTable player;
+    player.set_net_table_name("DT_Player");
+    for (const char* name : {"m_iHealth", "m_iArmor"})
+    {
+        auto* property = player.add_props();
+        property->set_type(Property::Kind::INT32);
+        property->set_var_name(name);
+        property->set_flags(Property::Flags::UNSIGNED);
+        property->set_num_bits(8);
+    }
+    append_send_table(tables, player);
+    CSVCMsg_SendTable end;
+    end.set_is_end(true);
+    append_send_table(tables, end);
+    uint16_t count = 1;
+    tables.append(reinterpret_cast<const char*>(&count), 2);
+    append_server_class(tables, 0, "CPlayer", "DT_Player");
+
+    BitWriter baseline;
+    write_first_indices(baseline, 2);
+    baseline.write(100, 8);
+    baseline.write(0, 8);
+
+    BitWriter strings;
+    strings.write(0, 1);  // verification bit
+    strings.write(1, 1);  // auto increment
+    strings.write(1, 1);  // has string
+    strings.write(0, 1);  // not appended to history
+    strings.write_string("0");
+    strings.write(1, 1);  // has data
+    strings.write(baseline.data.size(), 14);
+    for (char c : baseline.data)
+    {
+        strings.write(static_cast<uint8_t>(c), 8);
+    }
+
+    CSVCMsg_CreateStringTable instance_baseline;
+    instance_baseline.set_name("instancebaseline");
+    instance_baseline.set_max_entries(2);
+    instance_baseline.set_num_entries(1);
+    instance_baseline.set_string_data(strings.data);
+    std::string sign_on;
+    append_message(sign_on, SVC_Messages::svc_CreateStringTable, instance_baseline);
+
+    BitWriter create;
+    create.write(0, 6);  // entity index skip
+    create.write(0b10, 2);  // create
+    create.write(0, csgopp::common::bits::width(1) + 1);  // server class
+    create.write(0, 10);  // serial number
+    write_first_indices(create, 2);
+    create.write(90, 8);
+    create.write(50, 8);
+
+    BitWriter update;
+    update.write(0, 6);
+    update.write(0b00, 2);  // update
+    write_first_indices(update, 1);
+    update.write(80, 8);
+
+    std::string demo = demo_builder::make_header();
+    append_frame(demo, Command::DATA_TABLES, 0, tables);
+    append_frame(demo, Command::SIGN_ON, 0, sign_on);
+    append_frame(demo, Command::PACKET, 1, make_packet_entities(create, 1));
+    append_frame(demo, Command::PACKET, 2, make_packet_entities(update, 1));
+    append_frame(demo, Command::STOP, 3, "");
+    return demo;
+}
+
+/// Overrides the hooks on a subclass of `FileClient`, as the Python
+/// bindings do, rather than through its template argument
+struct UpdateObservingFileClient : public FileClient<Client>
+{
+    using FileClient::FileClient;
+
+    size_t creations{0};
+    std::vector<std::vector<uint16_t>> before;
+    std::vector<std::vector<uint16_t>> after;
+
+    void on_entity_creation(const std::shared_ptr<const Entity>& entity) override { this->creations += 1; }
+
+    void before_entity_update(const std::shared_ptr<const Entity>& entity, const std::vector<uint16_t>& indices) override
+    {
+        this->before.push_back(indices);
+    }
+
+    void on_entity_update(const std::shared_ptr<const Entity>& entity, const std::vector<uint16_t>& indices) override
+    {
+        this->after.push_back(indices);
+    }
+};
+
+TEST(Client, observes_entity_updates)
+{
+    Client client;
+    EXPECT_TRUE(client.observes_entity_updates());
+    client.set_observes_entity_updates(false);
+    EXPECT_FALSE(client.observes_entity_updates());
+}
+
+TEST(Client, events_only_skips_types)
+{
+    std::string demo = make_entity_demo();
+    ArrayInputStream input(demo.data(), static_cast<int>(demo.size()));
+    CodedInputStream stream(&input);
+    Client client(stream);
+    client.set_events_only(true);
+    while (client.advance(stream));
+
+    ASSERT_EQ(client.server_classes().size(), 1);
+    EXPECT_EQ(client.server_classes().at(0)->type(), nullptr);
+}
+
+TEST(Client, file_client_subclass_entity_update)
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "csgopp_client_entity_update.dem";
+    {
+        std::string demo = make_entity_demo();
+        std::ofstream out(path, std::ios::binary);
+        out.write(demo.data(), static_cast<std::streamsize>(demo.size()));
+    }
+
+    {
+        UpdateObservingFileClient client(path);
+        EXPECT_TRUE(client.observes_entity_updates());
+        while (client.advance());
+        EXPECT_EQ(client.creations, 1);
+        EXPECT_EQ(client.before, std::vector<std::vector<uint16_t>>({{0}}));
+        EXPECT_EQ(client.after, client.before);
+    }
+
+    {
+        UpdateObservingFileClient client(path);
+        client.set_observes_entity_updates(false);
+        while (client.advance());
+        EXPECT_EQ(client.creations, 1);
+        EXPECT_TRUE(client.after.empty());
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(Client, file_client_jump_out_of_range)
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "csgopp_client_jump.dem";
+    {
+        std::string demo = make_entity_demo();
+        std::ofstream out(path, std::ios::binary);
+        out.write(demo.data(), static_cast<std::streamsize>(demo.size()));
+    }
+
+    {
+        FileClient<> client(path);
+        ASSERT_TRUE(client.advance());
+        int64_t position = client.position();
+        EXPECT_THROW(client.jump(uint64_t(1) << 32), csgopp::error::GameError);
+        EXPECT_EQ(client.position(), position);
+        while (client.advance());
+        EXPECT_EQ(client.entities().at(0)->server_class->name, "CPlayer");
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(Client, track_columns_mid_stream)
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "csgopp_client_track_columns.dem";
+    {
+        std::string demo = make_entity_demo();
+        std::ofstream out(path, std::ios::binary);
+        out.write(demo.data(), static_cast<std::streamsize>(demo.size()));
+    }
+
+    {
+        FileClient<> client(path);
+        ASSERT_TRUE(client.advance());  // data tables
+        ASSERT_TRUE(client.advance());  // sign on
+        ASSERT_TRUE(client.advance());  // creation
+        ASSERT_TRUE(client.entities().at(0) != nullptr);
+
+        // Stores registered after creation are seeded with live entities
+        std::shared_ptr<const ColumnStore> first = client.track_columns("CPlayer", {"m_iHealth", "m_iArmor"});
+        ASSERT_EQ(first->size(), 1);
+        EXPECT_TRUE(first->present()[0]);
+        EXPECT_EQ(first->column<uint32_t>("m_iHealth")[0], 90);
+        EXPECT_EQ(first->column<uint32_t>("m_iArmor")[0], 50);
+
+        // Registering another store must not disturb the first
+        std::shared_ptr<const ColumnStore> second = client.track_columns("CPlayer", {"m_iArmor"});
+        EXPECT_EQ(first->column<uint32_t>("m_iHealth")[0], 90);
+        EXPECT_EQ(first->column<uint32_t>("m_iArmor")[0], 50);
+        EXPECT_EQ(second->column<uint32_t>("m_iArmor")[0], 50);
+
+        // Both are updated, keeping properties that didn't change
+        while (client.advance());
+        EXPECT_TRUE(first->present()[0]);
+        EXPECT_EQ(first->column<uint32_t>("m_iHealth")[0], 80);
+        EXPECT_EQ(first->column<uint32_t>("m_iArmor")[0], 50);
+        EXPECT_TRUE(second->present()[0]);
+        EXPECT_EQ(second->column<uint32_t>("m_iArmor")[0], 50);
+    }
+
+    std::filesystem::remove(path);
+}
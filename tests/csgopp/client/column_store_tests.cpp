@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/client/column_store.h>
+#include <csgopp/client/data_table.h>
+#include <csgopp/common/vector.h>
+
+#include "player_table.h"
+
+using namespace csgopp::client::column_store;
+using csgopp::common::vector::Vector3;
+using player_table::DataTable;
+using player_table::make_server_class;
+using player_table::make_weapon_server_class;
+using player_table::Property;
+using player_table::prioritized_index;
+
+TEST(ColumnStore, columns)
+{
+    std::shared_ptr<ServerClass> server_class = make_server_class();
+    std::shared_ptr<const EntityType> type = server_class->data_table->type();
+
+    ColumnStore store("CPlayer", {"m_iHealth", "m_vecOrigin"});
+    store.bind(server_class);
+    EXPECT_EQ(store.columns().size(), 2);
+
+    Entity first(std::shared_ptr<const EntityType>(type), 3, server_class);
+    first["m_iHealth"].is<int32_t>() = 100;
+    first["m_vecOrigin"].is<Vector3>().z = 3;
+    store.assign(first);
+
+    Entity second(std::shared_ptr<const EntityType>(type), 5, server_class);
+    second["m_iHealth"].is<int32_t>() = 80;
+    store.assign(second);
+
+    std::span<const int32_t> health = store.column<int32_t>("m_iHealth");
+    EXPECT_EQ(health.size(), 6);
+    EXPECT_EQ(health[3], 100);
+    EXPECT_EQ(health[5], 80);
+    EXPECT_EQ(store.column<Vector3>("m_vecOrigin")[3].z, 3);
+    EXPECT_TRUE(store.present()[3]);
+    EXPECT_FALSE(store.present()[4]);
+
+    // Only changed properties are copied on update
+    first["m_iHealth"].is<int32_t>() = 50;
+    first["m_vecOrigin"].is<Vector3>().z = 6;
+    store.update(first, {prioritized_index(*type, "m_iHealth")});
+    EXPECT_EQ(store.column<int32_t>("m_iHealth")[3], 50);
+    EXPECT_EQ(store.column<Vector3>("m_vecOrigin")[3].z, 3);
+
+    store.erase(5);
+    EXPECT_FALSE(store.present()[5]);
+}
+
+TEST(ColumnStore, errors)
+{
+    std::shared_ptr<ServerClass> server_class = make_server_class();
+
+    ColumnStore missing("CPlayer", {"m_iArmor"});
+    EXPECT_THROW(missing.bind(server_class), ColumnStoreError);
+
+    ColumnStore string("CPlayer", {"m_szName"});
+    EXPECT_THROW(string.bind(server_class), ColumnStoreError);
+
+    ColumnStore store("CPlayer", {"m_iHealth"});
+    store.bind(server_class);
+    EXPECT_THROW((void) store.column<float>("m_iHealth"), ColumnStoreError);
+    EXPECT_THROW((void) store.column<int32_t>("m_vecOrigin"), ColumnStoreError);
+}
+
+TEST(ColumnStore, array_errors)
+{
+    std::shared_ptr<ServerClass> server_class = make_weapon_server_class<DataTable::FloatProperty>(Property::Kind::FLOAT, "m_flSpread", 2);
+
+    ColumnStore store("CWeapon", {"m_flSpread"});
+    store.bind(server_class);
+    Entity entity(server_class->data_table->type(), 1, server_class);
+    entity["m_flSpread"][1].is<float>() = 0.5f;
+    store.assign(entity);
+    EXPECT_EQ((store.column<std::array<float, 2>>("m_flSpread")[1][1]), 0.5f);
+
+    // Same size as the array, but not its values
+    EXPECT_THROW((void) store.column<uint64_t>("m_flSpread"), ColumnStoreError);
+    EXPECT_THROW((void) (store.column<std::array<int32_t, 2>>("m_flSpread")), ColumnStoreError);
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/client/data_table/data_property.h>
+#include <csgopp/client/data_table/decode_plan.h>
+#include <csgopp/common/vector.h>
+
+#include <cstring>
+#include <random>
+
+#include "entity_builder.h"
+
+using namespace csgopp::client::data_table::data_property;
+using csgopp::client::data_table::decode::InlineString;
+using csgopp::client::data_table::decode_plan::DecodePlan;
+using csgopp::client::data_table::property::Property;
+using csgopp::common::bits::BitStream;
+using csgopp::common::vector::Vector3;
+using entity_builder::make_send_prop;
+
+static std::string random_bytes(size_t size, uint32_t seed)
+{
+    std::mt19937 generator(seed);
+    std::string bytes(size, '\0');
+    for (char& byte : bytes)
+    {
+        byte = static_cast<char>(generator());
+    }
+    return bytes;
+}
+
+/// Decode the same bits with the virtual update and the plan, then compare
+/// the resulting values and the number of bits consumed.
+template<typename T>
+static void expect_equivalent(DataProperty& property, uint32_t seed = 0)
+{
+    std::shared_ptr<const object::Type> type = property.construct_type();
+    DecodePlan plan;
+    plan.add(property, 0);
+
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        std::string bytes = random_bytes(256, seed + i);
+
+        T expected{};
+        BitStream expected_stream(bytes);
+        property.type()->update(reinterpret_cast<char*>(&expected), expected_stream, &property);
+
+        T actual{};
+        BitStream actual_stream(bytes);
+        plan.decode(reinterpret_cast<char*>(&actual), actual_stream, uint16_t{0});
+
+        EXPECT_EQ(std::memcmp(&expected, &actual, sizeof(T)), 0);
+        EXPECT_EQ(expected_stream.tell(), actual_stream.tell());
+    }
+}
+
+TEST(DecodePlan, integers)
+{
+    Int32Property boolean(make_send_prop(Property::Kind::INT32, "m_value", Property::Flags::UNSIGNED, 1));
+    expect_equivalent<bool>(boolean);
+
+    Int32Property unsigned_fixed(make_send_prop(Property::Kind::INT32, "m_value", Property::Flags::UNSIGNED, 11));
+    expect_equivalent<uint32_t>(unsigned_fixed);
+
+    Int32Property signed_fixed(make_send_prop(Property::Kind::INT32, "m_value", 0, 17));
+    expect_equivalent<int32_t>(signed_fixed);
+
+    Int32Property signed_variable(make_send_prop(Property::Kind::INT32, "m_value", Property::Flags::VARIABLE_INTEGER, 32));
+    expect_equivalent<int32_t>(signed_variable);
+
+    Int64Property unsigned_wide(make_send_prop(Property::Kind::INT64, "m_value", Property::Flags::UNSIGNED, 64));
+    expect_equivalent<uint64_t>(unsigned_wide);
+
+    Int64Property signed_wide(make_send_prop(Property::Kind::INT64, "m_value", 0, 40));
+    expect_equivalent<int64_t>(signed_wide);
+}
+
+TEST(DecodePlan, floats)
+{
+    FloatProperty scaled(make_send_prop(Property::Kind::FLOAT, "m_value", 0, 10, -4.f, 12.f));
+    expect_equivalent<float>(scaled);
+
+    FloatProperty coordinates(make_send_prop(Property::Kind::FLOAT, "m_value", Property::Flags::COORDINATES, 0));
+    expect_equivalent<float>(coordinates);
+
+    FloatProperty cell(make_send_prop(Property::Kind::FLOAT, "m_value", Property::Flags::CELL_COORDINATES, 15));
+    expect_equivalent<float>(cell);
+
+    Vector3Property vector(make_send_prop(Property::Kind::VECTOR3, "m_value", 0, 12, 0.f, 1024.f));
+    expect_equivalent<Vector3>(vector);
+
+    Vector3Property normal(make_send_prop(Property::Kind::VECTOR3, "m_value", Property::Flags::NORMAL, 0));
+    expect_equivalent<Vector3>(normal);
+}
+
+TEST(DecodePlan, string)
+{
+    StringProperty property(make_send_prop(Property::Kind::STRING, "m_value", 0, 0));
+    (void)property.construct_type();
+    DecodePlan plan;
+    plan.add(property, 0);
+
+    // Nine bits of size followed by the string itself, so shift by one
+    std::string payload = "hello";
+    std::vector<uint8_t> bits(16, 0);
+    bits[0] = 5;
+    for (size_t i = 0; i < payload.size(); ++i)
+    {
+        bits[1 + i] |= static_cast<uint8_t>(payload[i] << 1);
+        bits[2 + i] |= static_cast<uint8_t>(static_cast<uint8_t>(payload[i]) >> 7);
+    }
+
+    std::string expected;
+    BitStream expected_stream(bits);
+    property.type()->update(reinterpret_cast<char*>(&expected), expected_stream, &property);
+
+    std::string actual;
+    BitStream actual_stream(bits);
+    plan.decode(reinterpret_cast<char*>(&actual), actual_stream, uint16_t{0});
+
+    EXPECT_EQ(actual, "hello");
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(expected_stream.tell(), actual_stream.tell());
+}
+
+TEST(DecodePlan, inline_string)
+{
+    StringProperty property(make_send_prop(Property::Kind::STRING, "m_value", 0, 0), true);
+    EXPECT_EQ(property.construct_type()->size(), sizeof(InlineString));
+    DecodePlan plan;
+    plan.add(property, 0);
+
+    // Random sizes and contents must match the allocating decode
+    StringProperty allocating(make_send_prop(Property::Kind::STRING, "m_value", 0, 0));
+    for (uint32_t seed = 0; seed < 64; ++seed)
+    {
+        std::string bytes = random_bytes(1024, seed);
+
+        std::string expected;
+        BitStream expected_stream(bytes);
+        allocating.type()->update(reinterpret_cast<char*>(&expected), expected_stream, &allocating);
+
+        InlineString actual;
+        BitStream actual_stream(bytes);
+        property.type()->update(reinterpret_cast<char*>(&actual), actual_stream, &property);
+
+        InlineString planned;
+        BitStream planned_stream(bytes);
+        plan.decode(reinterpret_cast<char*>(&planned), planned_stream, uint16_t{0});
+
+        EXPECT_EQ(actual.view(), expected);
+        EXPECT_EQ(planned.view(), expected);
+        EXPECT_EQ(actual.data[actual.size], '\0');
+        EXPECT_EQ(expected_stream.tell(), actual_stream.tell());
+        EXPECT_EQ(expected_stream.tell(), planned_stream.tell());
+    }
+}
+
+TEST(DecodePlan, array)
+{
+    ArrayProperty property(
+        make_send_prop(Property::Kind::ARRAY, "m_value", 0, 0),
+        std::make_unique<Int32Property>(make_send_prop(Property::Kind::INT32, "m_value", Property::Flags::UNSIGNED, 6)));
+    property.length = 7;
+    (void)property.construct_type();
+    DecodePlan plan;
+    plan.add(property, 0);
+
+    // Three bits of length, then up to seven six-bit elements
+    std::vector<uint8_t> bits(16, 0xff);
+    bits[0] = 0b11111101;
+
+    uint32_t expected[7]{};
+    BitStream expected_stream(bits);
+    property.type()->update(reinterpret_cast<char*>(expected), expected_stream, &property);
+
+    uint32_t actual[7]{};
+    BitStream actual_stream(bits);
+    plan.decode(reinterpret_cast<char*>(actual), actual_stream, uint16_t{0});
+
+    EXPECT_EQ(std::memcmp(expected, actual, sizeof(actual)), 0);
+    EXPECT_EQ(actual[4], 63);
+    EXPECT_EQ(actual[5], 0);
+    EXPECT_EQ(expected_stream.tell(), actual_stream.tell());
+}
+
+TEST(DecodePlan, array_too_long)
+{
+    ArrayProperty property(
+        make_send_prop(Property::Kind::ARRAY, "m_value", 0, 0),
+        std::make_unique<Int32Property>(make_send_prop(Property::Kind::INT32, "m_value", Property::Flags::UNSIGNED, 6)));
+    property.length = 4;
+    (void)property.construct_type();
+    DecodePlan plan;
+    plan.add(property, 0);
+
+    // Four elements need three length bits, which can encode up to seven
+    std::vector<uint8_t> bits(16, 0xff);
+    uint32_t values[4]{};
+    BitStream stream(bits);
+    EXPECT_THROW(plan.decode(reinterpret_cast<char*>(values), stream, uint16_t{0}), csgopp::error::GameError);
+}
+
+TEST(DecodePlan, index_out_of_range)
+{
+    Int32Property property(make_send_prop(Property::Kind::INT32, "m_value", Property::Flags::UNSIGNED, 8));
+    DecodePlan plan;
+    plan.add(property, 0);
+
+    std::vector<uint8_t> bits(16, 0xff);
+    uint32_t value{};
+    BitStream stream(bits);
+    EXPECT_THROW(plan.decode(reinterpret_cast<char*>(&value), stream, std::vector<uint16_t>{0, 1}), csgopp::error::GameError);
+    EXPECT_EQ(value, 0xff);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/client/entity_pool.h>
+#include <csgopp/client/data_table/data_type.h>
+
+#include "entity_builder.h"
+
+using csgopp::client::data_table::data_type::SignedInt32Type;
+using csgopp::client::data_table::data_type::StringType;
+using csgopp::client::entity::Baseline;
+using csgopp::client::entity::Entity;
+using csgopp::client::entity::EntityType;
+using csgopp::client::entity_pool::EntityPool;
+using entity_builder::make_entity_type;
+using object::shared;
+
+static std::shared_ptr<EntityType> make_pooled_type()
+{
+    return make_entity_type({{"number", shared<SignedInt32Type>()}, {"name", shared<StringType>()}});
+}
+
+TEST(EntityPool, recycle)
+{
+    std::shared_ptr<EntityType> type = make_pooled_type();
+    auto pool = std::make_shared<EntityPool>();
+
+    std::shared_ptr<Entity> entity = pool->acquire(type, 1, nullptr, nullptr);
+    (*entity)["number"].is<int32_t>() = 42;
+    (*entity)["name"].is<std::string>() = "stale";
+    const Entity* address = entity.get();
+
+    // Observers may hold on to an entity past its deletion
+    std::shared_ptr<const Entity> observer = entity;
+    entity.reset();
+    EXPECT_EQ(pool->statistics().retained, 0);
+    observer.reset();
+    EXPECT_EQ(pool->statistics().retained, 1);
+    EXPECT_EQ(pool->statistics().bytes_retained, type->size());
+
+    // Reuse resets to a default instance without a baseline
+    std::shared_ptr<Entity> reused = pool->acquire(type, 2, nullptr, nullptr);
+    EXPECT_TRUE(reused.get() == address);
+    EXPECT_EQ(reused->id, 2);
+    EXPECT_EQ((*reused)["number"].is<int32_t>(), 0);
+    EXPECT_EQ((*reused)["name"].is<std::string>(), "");
+    reused.reset();
+
+    Baseline baseline(type);
+    baseline["number"].is<int32_t>() = 7;
+    baseline["name"].is<std::string>() = "baseline";
+    std::shared_ptr<Entity> from_baseline = pool->acquire(type, 3, nullptr, &baseline);
+    EXPECT_EQ((*from_baseline)["number"].is<int32_t>(), 7);
+    EXPECT_EQ((*from_baseline)["name"].is<std::string>(), "baseline");
+
+    csgopp::client::entity_pool::Statistics statistics = pool->statistics();
+    EXPECT_EQ(statistics.hits, 2);
+    EXPECT_EQ(statistics.misses, 1);
+    EXPECT_EQ(statistics.recycled, 2);
+    EXPECT_DOUBLE_EQ(statistics.hit_rate(), 2.0 / 3.0);
+}
+
+TEST(EntityPool, limit)
+{
+    std::shared_ptr<EntityType> type = make_pooled_type();
+    auto pool = std::make_shared<EntityPool>(type->size());
+
+    std::shared_ptr<Entity> first = pool->acquire(type, 1, nullptr, nullptr);
+    std::shared_ptr<Entity> second = pool->acquire(type, 2, nullptr, nullptr);
+    first.reset();
+    second.reset();
+
+    csgopp::client::entity_pool::Statistics statistics = pool->statistics();
+    EXPECT_EQ(statistics.retained, 1);
+    EXPECT_EQ(statistics.discarded, 1);
+
+    pool->clear();
+    EXPECT_EQ(pool->statistics().retained, 0);
+    EXPECT_EQ(pool->statistics().bytes_retained, 0);
+}
+
+TEST(EntityPool, outlives_pool)
+{
+    std::shared_ptr<EntityType> type = make_pooled_type();
+    std::shared_ptr<Entity> entity;
+    {
+        auto pool = std::make_shared<EntityPool>();
+        entity = pool->acquire(type, 1, nullptr, nullptr);
+    }
+    (*entity)["name"].is<std::string>() = "still alive";
+    entity.reset();
+}
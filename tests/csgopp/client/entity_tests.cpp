@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/client/entity.h>
+#include <csgopp/client/data_table/data_type.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "entity_builder.h"
+#include "player_table.h"
+
+using csgopp::client::data_table::data_type::DataArrayType;
+using csgopp::client::data_table::data_type::FloatType;
+using csgopp::client::data_table::data_type::InlineStringType;
+using csgopp::client::data_table::data_type::SignedInt32Type;
+using csgopp::client::data_table::data_type::StringType;
+using csgopp::client::data_table::decode::InlineString;
+using csgopp::client::entity::Baseline;
+using csgopp::client::entity::Entity;
+using csgopp::client::entity::EntityMask;
+using csgopp::client::entity::EntityType;
+using object::ObjectType;
+using csgopp::client::server_class::ServerClass;
+using entity_builder::make_entity_type;
+using object::shared;
+using player_table::make_server_class;
+using player_table::prioritized_index;
+
+static std::shared_ptr<EntityType> make_nested_type()
+{
+    ObjectType::Builder inner;
+    inner.member("label", shared<StringType>());
+    inner.member("weight", shared<FloatType>());
+
+    return make_entity_type({
+        {"number", shared<SignedInt32Type>()},
+        {"name", shared<StringType>()},
+        {"inner", std::make_shared<ObjectType>(std::move(inner))},
+        {"names", std::make_shared<DataArrayType>(shared<StringType>(), 3)},
+        {"last", shared<SignedInt32Type>()},
+    });
+}
+
+TEST(EntityType, strings)
+{
+    std::shared_ptr<EntityType> type = make_nested_type();
+    EXPECT_EQ(type->strings.size(), 5);
+    EXPECT_TRUE(std::is_sorted(type->strings.begin(), type->strings.end()));
+}
+
+TEST(EntityType, copy)
+{
+    std::shared_ptr<EntityType> type = make_nested_type();
+    Baseline source(type);
+    source["number"].is<int32_t>() = -42;
+    source["name"].is<std::string>() = "hello";
+    source["inner"]["label"].is<std::string>() = std::string(600, 'x');
+    source["inner"]["weight"].is<float>() = 1.5f;
+    source["names"][1].is<std::string>() = "world";
+    source["last"].is<int32_t>() = 7;
+
+    Baseline destination(type);
+    destination["names"][2].is<std::string>() = "stale";
+    type->copy(source.address.get(), destination.address.get());
+
+    EXPECT_EQ(destination["number"].is<int32_t>(), -42);
+    EXPECT_EQ(destination["name"].is<std::string>(), "hello");
+    EXPECT_EQ(destination["inner"]["label"].is<std::string>(), std::string(600, 'x'));
+    EXPECT_EQ(destination["inner"]["weight"].is<float>(), 1.5f);
+    EXPECT_EQ(destination["names"][0].is<std::string>(), "");
+    EXPECT_EQ(destination["names"][1].is<std::string>(), "world");
+    EXPECT_EQ(destination["names"][2].is<std::string>(), "");
+    EXPECT_EQ(destination["last"].is<int32_t>(), 7);
+
+    // The copy must not share storage with the source
+    source["name"].is<std::string>() = "changed";
+    EXPECT_EQ(destination["name"].is<std::string>(), "hello");
+}
+
+TEST(EntityType, copy_inline_strings)
+{
+    ObjectType::Builder builder;
+    builder.member("number", shared<SignedInt32Type>());
+    builder.member("name", shared<InlineStringType>());
+    builder.member("names", std::make_shared<DataArrayType>(shared<InlineStringType>(), 2));
+    auto type = std::make_shared<EntityType>(std::move(builder));
+    type->compile();
+    EXPECT_TRUE(type->trivially_copyable());
+    EXPECT_FALSE(make_nested_type()->trivially_copyable());
+
+    Baseline source(type);
+    source["number"].is<int32_t>() = 3;
+    auto& name = source["name"].is<InlineString>();
+    std::memcpy(name.data, "hello", 5);
+    name.size = 5;
+
+    Baseline destination(type);
+    type->copy(source.address.get(), destination.address.get());
+    EXPECT_EQ(destination["number"].is<int32_t>(), 3);
+    EXPECT_EQ(destination["name"].is<InlineString>().view(), "hello");
+    EXPECT_EQ(destination["names"][1].is<InlineString>().view(), "");
+}
+
+TEST(EntityMask, bits)
+{
+    EntityMask mask(130);
+    EXPECT_FALSE(mask.any());
+    mask.set(0);
+    mask.set(129);
+    EXPECT_TRUE(mask.test(0));
+    EXPECT_FALSE(mask.test(64));
+    EXPECT_TRUE(mask.test(129));
+
+    EntityMask other(130);
+    other.set(64);
+    EXPECT_FALSE(mask.intersects(other));
+    other |= mask;
+    EXPECT_TRUE(mask.intersects(other));
+
+    mask.reset();
+    EXPECT_FALSE(mask.any());
+    mask.fill();
+    EXPECT_TRUE(mask.test(129));
+    EXPECT_TRUE(mask.test(100));
+}
+
+TEST(EntityMask, of)
+{
+    std::shared_ptr<ServerClass> server_class = make_server_class();
+    std::shared_ptr<const EntityType> type = server_class->data_table->type();
+    uint16_t health = prioritized_index(*type, "m_iHealth");
+    uint16_t origin = prioritized_index(*type, "m_vecOrigin");
+
+    EntityMask by_name = EntityMask::of(*type, std::vector<std::string>{"m_iHealth"});
+    EXPECT_TRUE(by_name.test(health));
+    EXPECT_FALSE(by_name.test(origin));
+    EXPECT_THROW(EntityMask::of(*type, std::vector<std::string>{"m_iArmor"}), csgopp::error::GameError);
+
+    EntityMask by_accessor = EntityMask::of(*type, object::Accessor(type)["m_vecOrigin"]);
+    EXPECT_FALSE(by_accessor.test(health));
+    EXPECT_TRUE(by_accessor.test(origin));
+
+    Entity entity(std::shared_ptr<const EntityType>(type), 1, server_class);
+    entity.dirty.set(health);
+    entity.dirty_tick = 10;
+    EXPECT_TRUE(entity.changed(by_name, 10));
+    EXPECT_FALSE(entity.changed(by_name, 11));
+    EXPECT_FALSE(entity.changed(by_accessor, 10));
+}
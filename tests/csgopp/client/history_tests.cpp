@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/client/history.h>
+#include <csgopp/client/data_table/data_type.h>
+
+#include "entity_builder.h"
+
+using csgopp::client::data_table::data_type::SignedInt32Type;
+using csgopp::client::entity::Entity;
+using csgopp::client::entity::EntityType;
+using csgopp::client::entity_pool::EntityPool;
+using csgopp::client::history::History;
+using csgopp::client::history::HistoryError;
+using entity_builder::make_entity_type;
+using object::shared;
+
+static std::shared_ptr<EntityType> make_history_type()
+{
+    return make_entity_type({{"number", shared<SignedInt32Type>()}});
+}
+
+static int32_t number(const std::shared_ptr<const Entity>& entity)
+{
+    return (*entity)["number"].is<int32_t>();
+}
+
+TEST(History, find)
+{
+    auto pool = std::make_shared<EntityPool>();
+    History history(pool, 10, 64);
+
+    // Created at tick 10, then updated twice at 12 and once at 14
+    history.before_replace(10, 1, nullptr);
+    std::shared_ptr<Entity> entity = pool->acquire(make_history_type(), 1, nullptr, nullptr);
+    (*entity)["number"].is<int32_t>() = 1;
+    history.before_update(12, *entity);
+    (*entity)["number"].is<int32_t>() = 2;
+    history.before_update(12, *entity);
+    (*entity)["number"].is<int32_t>() = 3;
+    history.before_update(14, *entity);
+    (*entity)["number"].is<int32_t>() = 4;
+
+    EXPECT_EQ(history.size(), 3);
+    EXPECT_EQ(history.bytes(), 2 * sizeof(int32_t));
+
+    std::optional<std::shared_ptr<const Entity>> state = history.find(1, 10);
+    ASSERT_TRUE(state.has_value());
+    EXPECT_EQ(number(*state), 1);
+    EXPECT_EQ(number(*history.find(1, 11)), 1);
+    EXPECT_EQ(number(*history.find(1, 12)), 3);
+    EXPECT_FALSE(history.find(1, 14).has_value());
+    EXPECT_FALSE(history.find(2, 10).has_value());
+
+    // Deleting keeps the entity itself rather than a copy
+    history.before_replace(15, 1, entity);
+    EXPECT_TRUE(*history.find(1, 14) == entity);
+    EXPECT_EQ(number(*history.find(1, 14)), 4);
+
+    EXPECT_FALSE(history.covers(9));
+    EXPECT_THROW((void)history.find(1, 9), HistoryError);
+}
+
+TEST(History, created)
+{
+    auto pool = std::make_shared<EntityPool>();
+    History history(pool, 0, 64);
+    history.before_replace(5, 3, nullptr);
+
+    std::optional<std::shared_ptr<const Entity>> state = history.find(3, 4);
+    ASSERT_TRUE(state.has_value());
+    EXPECT_TRUE(*state == nullptr);
+}
+
+TEST(History, window)
+{
+    auto pool = std::make_shared<EntityPool>();
+    std::shared_ptr<Entity> entity = pool->acquire(make_history_type(), 0, nullptr, nullptr);
+    History history(pool, 0, 4);
+    for (int32_t tick = 1; tick <= 10; ++tick)
+    {
+        history.before_update(tick, *entity);
+        (*entity)["number"].is<int32_t>() = tick;
+    }
+
+    // Only ticks within the last four are kept
+    EXPECT_EQ(history.size(), 4);
+    EXPECT_FALSE(history.covers(5));
+    EXPECT_TRUE(history.covers(6));
+    EXPECT_EQ(number(*history.find(0, 6)), 6);
+    EXPECT_EQ(number(*history.find(0, 9)), 9);
+    EXPECT_EQ(history.bytes(), 4 * sizeof(int32_t));
+}
+
+TEST(History, budget)
+{
+    auto pool = std::make_shared<EntityPool>();
+    std::shared_ptr<Entity> entity = pool->acquire(make_history_type(), 0, nullptr, nullptr);
+    History history(pool, 0, 64, 3 * sizeof(int32_t));
+    for (int32_t tick = 1; tick <= 10; ++tick)
+    {
+        history.before_update(tick, *entity);
+        (*entity)["number"].is<int32_t>() = tick;
+    }
+
+    EXPECT_EQ(history.size(), 3);
+    EXPECT_LE(history.bytes(), history.budget());
+    EXPECT_TRUE(history.covers(7));
+    EXPECT_FALSE(history.covers(6));
+    EXPECT_EQ(number(*history.find(0, 7)), 7);
+
+    history.clear(10);
+    EXPECT_EQ(history.size(), 0);
+    EXPECT_EQ(history.bytes(), 0);
+    EXPECT_FALSE(history.find(0, 10).has_value());
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/client.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <string>
+#include <vector>
+
+#include "demo_builder.h"
+
+using namespace csgopp::client;
+using csgo::message::net::NET_Messages;
+using csgo::message::net::SVC_Messages;
+using demo_builder::append_frame;
+using demo_builder::append_message;
+using google::protobuf::io::ArrayInputStream;
+
+static std::string make_frame(const std::string& packet)
+{
+    std::string frame;
+    append_frame(frame, csgopp::demo::Command::PACKET, 0, packet);
+    return frame;
+}
+
+class RecordingClient : public Client
+{
+public:
+    std::vector<uint32_t> before;
+    std::vector<uint32_t> after;
+    size_t prints{0};
+
+    void before_packet(uint32_t type) override { this->before.push_back(type); }
+    void on_packet(uint32_t type) override { this->after.push_back(type); }
+
+    void advance_packet_print(CodedInputStream& stream) override
+    {
+        this->prints += 1;
+        Client::advance_packet_print(stream);
+    }
+};
+
+TEST(PacketFilter, bits)
+{
+    PacketFilter filter;
+    EXPECT_FALSE(filter.test(SVC_Messages::svc_Print));
+    filter.enable(SVC_Messages::svc_Print).enable(NET_Messages::net_PlayerAvatarData);
+    EXPECT_TRUE(filter.test(SVC_Messages::svc_Print));
+    EXPECT_TRUE(filter.test(NET_Messages::net_PlayerAvatarData));
+    EXPECT_FALSE(filter.test(NET_Messages::net_Tick));
+    filter.disable(SVC_Messages::svc_Print);
+    EXPECT_FALSE(filter.test(SVC_Messages::svc_Print));
+
+    // Out of range types are never filtered
+    EXPECT_TRUE(filter.test(PacketFilter::CAPACITY));
+    EXPECT_TRUE(PacketFilter().test(1000));
+
+    EXPECT_TRUE(PacketFilter::all().test(0));
+    EXPECT_TRUE(PacketFilter::all().test(127));
+    EXPECT_EQ(PacketFilter::all() & PacketFilter::required(), PacketFilter::required());
+    EXPECT_EQ(PacketFilter({1, 2}) | PacketFilter({3}), PacketFilter({1, 2, 3}));
+}
+
+TEST(PacketFilter, required)
+{
+    Client client;
+    EXPECT_EQ(client.packet_filter(), PacketFilter::all());
+
+    client.set_packet_filter(PacketFilter{SVC_Messages::svc_GameEvent});
+    EXPECT_TRUE(client.packet_filter().test(SVC_Messages::svc_GameEvent));
+    EXPECT_TRUE(client.packet_filter().test(SVC_Messages::svc_PacketEntities));
+    EXPECT_TRUE(client.packet_filter().test(SVC_Messages::svc_CreateStringTable));
+    EXPECT_FALSE(client.packet_filter().test(SVC_Messages::svc_Print));
+}
+
+TEST(PacketFilter, skip)
+{
+    std::string packet;
+    append_message(packet, SVC_Messages::svc_Print, "hello");
+    append_message(packet, NET_Messages::net_Tick, "tick");
+    append_message(packet, SVC_Messages::svc_Print, "world");
+    std::string frame = make_frame(packet);
+
+    {
+        RecordingClient client;
+        ArrayInputStream input(frame.data(), static_cast<int>(frame.size()));
+        CodedInputStream stream(&input);
+        EXPECT_TRUE(client.advance(stream));
+        EXPECT_EQ(client.prints, 2);
+        EXPECT_EQ(client.before, std::vector<uint32_t>({16, 4, 16}));
+        EXPECT_EQ(client.after, client.before);
+    }
+
+    {
+        RecordingClient client;
+        client.set_packet_filter(PacketFilter{NET_Messages::net_Tick});
+        ArrayInputStream input(frame.data(), static_cast<int>(frame.size()));
+        CodedInputStream stream(&input);
+        EXPECT_TRUE(client.advance(stream));
+        EXPECT_EQ(client.prints, 0);
+        EXPECT_EQ(client.before, std::vector<uint32_t>({4}));
+        EXPECT_EQ(client.after, client.before);
+        EXPECT_EQ(stream.CurrentPosition(), frame.size());
+    }
+}
+
+TEST(PacketFilter, events_only)
+{
+    std::string packet;
+    append_message(packet, SVC_Messages::svc_PacketEntities, "garbage");
+    append_message(packet, SVC_Messages::svc_Print, "hello");
+    std::string frame = make_frame(packet);
+
+    RecordingClient client;
+    client.set_packet_filter(PacketFilter{SVC_Messages::svc_Print});
+    client.set_events_only(true);
+    EXPECT_TRUE(client.events_only());
+    EXPECT_FALSE(client.packet_filter().test(SVC_Messages::svc_PacketEntities));
+    EXPECT_TRUE(client.packet_filter().test(SVC_Messages::svc_GameEventList));
+
+    ArrayInputStream input(frame.data(), static_cast<int>(frame.size()));
+    CodedInputStream stream(&input);
+    EXPECT_TRUE(client.advance(stream));
+    EXPECT_EQ(client.prints, 1);
+    EXPECT_EQ(client.before, std::vector<uint32_t>({16}));
+    EXPECT_THROW((void)client.entities(), csgopp::error::GameError);
+
+    client.set_events_only(false);
+    EXPECT_TRUE(client.packet_filter().test(SVC_Messages::svc_PacketEntities));
+    EXPECT_EQ(client.entities().size(), 0);
+}
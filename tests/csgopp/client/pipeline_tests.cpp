@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/client.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+#include "demo_builder.h"
+
+#include <string>
+#include <vector>
+
+using csgopp::client::Client;
+using csgopp::client::packet_filter::PacketFilter;
+using csgopp::client::pipeline::Frame;
+using csgopp::client::pipeline::Pipeline;
+using csgopp::demo::Command;
+using demo_builder::append_frame;
+using demo_builder::append_message;
+using google::protobuf::io::ArrayInputStream;
+using google::protobuf::io::CodedInputStream;
+
+/// Logs every frame and packet hook along with the tick it saw
+struct HookLogClient : public Client
+{
+    std::vector<std::string> log;
+
+    void before_frame() override { this->log.push_back("before_frame " + std::to_string(this->tick())); }
+    void on_frame(Command::Type command) override { this->log.push_back("on_frame " + std::to_string(command) + " " + std::to_string(this->tick())); }
+    void before_packet(uint32_t type) override { this->log.push_back("before_packet " + std::to_string(type)); }
+    void on_packet(uint32_t type) override { this->log.push_back("on_packet " + std::to_string(type)); }
+};
+
+static std::string make_pipeline_demo()
+{
+    using namespace csgo::message::net;
+
+    std::string packet;
+    CNETMsg_Tick tick;
+    tick.set_tick(3);
+    append_message(packet, NET_Messages::net_Tick, tick);
+    CSVCMsg_PacketEntities entities;
+    entities.set_max_entries(0);
+    entities.set_updated_entries(0);
+    entities.set_entity_data(std::string(40, '\x7F'));
+    append_message(packet, SVC_Messages::svc_PacketEntities, entities);
+    append_message(packet, NET_Messages::net_NOP, CNETMsg_NOP());
+
+    std::string demo;
+    append_frame(demo, Command::SYNC_TICK, 1, "");
+    append_frame(demo, Command::PACKET, 3, packet);
+    append_frame(demo, Command::CONSOLE_COMMAND, 4, "say hello");
+    append_frame(demo, Command::PACKET, 6, packet);
+    append_frame(demo, Command::STOP, 7, "");
+    return demo;
+}
+
+TEST(Pipeline, read)
+{
+    std::string demo = make_pipeline_demo();
+    ArrayInputStream input(demo.data(), static_cast<int>(demo.size()));
+    CodedInputStream stream(&input);
+
+    Frame frame;
+    ASSERT_TRUE(csgopp::client::pipeline::read(stream, frame));
+    EXPECT_EQ(frame.command, Command::SYNC_TICK);
+    EXPECT_EQ(frame.tick, 1);
+
+    ASSERT_TRUE(csgopp::client::pipeline::read(stream, frame));
+    EXPECT_EQ(frame.command, Command::PACKET);
+    ASSERT_EQ(frame.messages.size(), 3);
+    EXPECT_EQ(frame.messages[0].entities, nullptr);
+    ASSERT_NE(frame.messages[1].entities, nullptr);
+    EXPECT_EQ(frame.messages[1].entities->entity_data(), std::string(40, '\x7F'));
+    EXPECT_TRUE(frame.messages[1].data.empty());
+
+    ASSERT_TRUE(csgopp::client::pipeline::read(stream, frame));
+    EXPECT_EQ(frame.command, Command::CONSOLE_COMMAND);
+    EXPECT_TRUE(frame.messages.empty());
+    EXPECT_EQ(frame.data.size(), 4 + 9);
+    EXPECT_EQ(frame.end, stream.CurrentPosition());
+
+    ASSERT_TRUE(csgopp::client::pipeline::read(stream, frame));
+    ASSERT_TRUE(csgopp::client::pipeline::read(stream, frame));
+    EXPECT_EQ(frame.command, Command::STOP);
+    EXPECT_FALSE(csgopp::client::pipeline::read(stream, frame));
+}
+
+TEST(Pipeline, hooks)
+{
+    std::string demo = make_pipeline_demo();
+
+    HookLogClient expected;
+    {
+        ArrayInputStream input(demo.data(), static_cast<int>(demo.size()));
+        CodedInputStream stream(&input);
+        while (expected.advance(stream));
+    }
+
+    HookLogClient actual;
+    {
+        ArrayInputStream input(demo.data(), static_cast<int>(demo.size()));
+        CodedInputStream stream(&input);
+        Pipeline pipeline(stream, actual.packet_filter(), 2);
+        while (Frame* frame = pipeline.next())
+        {
+            if (!actual.advance(*frame))
+            {
+                break;
+            }
+        }
+        EXPECT_EQ(pipeline.next(), nullptr);
+    }
+
+    EXPECT_EQ(actual.log, expected.log);
+    EXPECT_EQ(actual.cursor(), expected.cursor());
+    EXPECT_EQ(actual.tick(), 7);
+}
+
+TEST(Pipeline, filtered)
+{
+    std::string demo = make_pipeline_demo();
+
+    HookLogClient expected;
+    expected.set_events_only(true);
+    {
+        ArrayInputStream input(demo.data(), static_cast<int>(demo.size()));
+        CodedInputStream stream(&input);
+        while (expected.advance(stream));
+    }
+
+    HookLogClient actual;
+    actual.set_events_only(true);
+    {
+        ArrayInputStream input(demo.data(), static_cast<int>(demo.size()));
+        CodedInputStream stream(&input);
+        Pipeline pipeline(stream, actual.packet_filter(), 2);
+        while (Frame* frame = pipeline.next())
+        {
+            for (const auto& message : frame->messages)
+            {
+                EXPECT_NE(message.command, csgo::message::net::SVC_Messages::svc_PacketEntities);
+                EXPECT_EQ(message.entities, nullptr);
+            }
+            if (!actual.advance(*frame))
+            {
+                break;
+            }
+        }
+    }
+
+    EXPECT_EQ(actual.log, expected.log);
+    EXPECT_EQ(actual.tick(), 7);
+}
+
+TEST(Pipeline, truncated)
+{
+    std::string demo = make_pipeline_demo();
+    demo.resize(demo.size() - 6);
+
+    ArrayInputStream input(demo.data(), static_cast<int>(demo.size()));
+    CodedInputStream stream(&input);
+    Pipeline pipeline(stream, PacketFilter::all());
+    EXPECT_THROW(
+        {
+            while (pipeline.next() != nullptr);
+        },
+        csgopp::client::pipeline::PipelineError);
+}
@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/client.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "demo_builder.h"
+
+using csgo::message::net::CSVCMsg_SendTable;
+using csgo::message::net::CSVCMsg_SendTable_sendprop_t;
+using csgopp::client::Client;
+using csgopp::client::data_table::property::Property;
+using csgopp::client::schema_cache::Schema;
+using csgopp::client::schema_cache::SchemaCache;
+using csgopp::client::schema_cache::SchemaCacheError;
+using csgopp::demo::Command;
+using demo_builder::append_frame;
+using demo_builder::append_send_table;
+using demo_builder::append_server_class;
+using google::protobuf::io::ArrayInputStream;
+using google::protobuf::io::CodedInputStream;
+
+static void add_property(CSVCMsg_SendTable& send_table, const std::string& name, uint32_t priority)
+{
+    CSVCMsg_SendTable_sendprop_t* property = send_table.add_props();
+    property->set_type(Property::Kind::INT32);
+    property->set_var_name(name);
+    property->set_num_bits(32);
+    property->set_priority(priority);
+}
+
+/// A demo holding nothing but a `DATA_TABLES` frame
+static std::string make_schema_demo()
+{
+    std::string data;
+    CSVCMsg_SendTable player;
+    player.set_net_table_name("DT_Player");
+    add_property(player, "m_iHealth", 10);
+    add_property(player, "m_iArmor", 1);
+    add_property(player, "m_iAccount", 5);
+    append_send_table(data, player);
+
+    CSVCMsg_SendTable world;
+    world.set_net_table_name("DT_World");
+    add_property(world, "m_iRound", 2);
+    append_send_table(data, world);
+
+    CSVCMsg_SendTable end;
+    end.set_is_end(true);
+    append_send_table(data, end);
+
+    uint16_t count = 2;
+    data.append(reinterpret_cast<const char*>(&count), 2);
+    append_server_class(data, 0, "CPlayer", "DT_Player");
+    append_server_class(data, 1, "CWorld", "DT_World");
+
+    std::string demo;
+    append_frame(demo, Command::DATA_TABLES, 0, data);
+    return demo;
+}
+
+static void parse_schema(Client& client, const std::string& demo)
+{
+    ArrayInputStream input(demo.data(), static_cast<int>(demo.size()));
+    CodedInputStream stream(&input);
+    ASSERT_TRUE(client.advance(stream));
+}
+
+static std::vector<std::string> prioritized_names(const Client& client)
+{
+    std::vector<std::string> names;
+    for (const auto& datum : client.server_classes().at(0)->data_table->type()->prioritized)
+    {
+        names.push_back(datum.qualified_name());
+    }
+    return names;
+}
+
+TEST(SchemaCache, shared)
+{
+    std::string demo = make_schema_demo();
+    Client uncached;
+    parse_schema(uncached, demo);
+
+    auto cache = std::make_shared<SchemaCache>();
+    Client first;
+    first.set_schema_cache(cache);
+    parse_schema(first, demo);
+    Client second;
+    second.set_schema_cache(cache);
+    parse_schema(second, demo);
+
+    EXPECT_EQ(cache->size(), 1);
+    EXPECT_EQ(cache->statistics().hits, 1);
+    EXPECT_EQ(cache->statistics().misses, 1);
+    EXPECT_TRUE(first.server_classes().at(1) == second.server_classes().at(1));
+    EXPECT_TRUE(first.data_tables().by_name.at("DT_Player") == second.data_tables().by_name.at("DT_Player"));
+    EXPECT_EQ(second.server_classes().by_name.at("CWorld")->index, 1);
+
+    std::vector<std::string> expected{"m_iArmor", "m_iAccount", "m_iHealth"};
+    EXPECT_EQ(prioritized_names(uncached), expected);
+    EXPECT_EQ(prioritized_names(second), expected);
+
+    // Inline strings change the types, so they need their own schema
+    Client inline_strings;
+    inline_strings.set_inline_strings(true);
+    inline_strings.set_schema_cache(cache);
+    parse_schema(inline_strings, demo);
+    EXPECT_EQ(cache->size(), 2);
+    EXPECT_FALSE(inline_strings.server_classes().at(0) == first.server_classes().at(0));
+}
+
+TEST(SchemaCache, disk)
+{
+    std::string demo = make_schema_demo();
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "csgopp_schema_cache";
+    std::filesystem::remove_all(directory);
+
+    {
+        auto cache = std::make_shared<SchemaCache>(directory);
+        Client client;
+        client.set_schema_cache(cache);
+        parse_schema(client, demo);
+        EXPECT_EQ(cache->statistics().misses, 1);
+    }
+
+    // A fresh cache, as in a new process, reads the orders back
+    auto cache = std::make_shared<SchemaCache>(directory);
+    Client client;
+    client.set_schema_cache(cache);
+    parse_schema(client, demo);
+    EXPECT_EQ(cache->statistics().disk_hits, 1);
+    EXPECT_EQ(prioritized_names(client), (std::vector<std::string>{"m_iArmor", "m_iAccount", "m_iHealth"}));
+
+    // A corrupt file is ignored
+    for (const auto& entry : std::filesystem::directory_iterator(directory))
+    {
+        std::ofstream(entry.path(), std::ios::binary | std::ios::trunc) << "CSGOPPSC";
+    }
+    auto corrupted = std::make_shared<SchemaCache>(directory);
+    Client recovered;
+    recovered.set_schema_cache(corrupted);
+    parse_schema(recovered, demo);
+    EXPECT_EQ(corrupted->statistics().misses, 1);
+    EXPECT_EQ(prioritized_names(recovered), prioritized_names(client));
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(SchemaCache, concurrent)
+{
+    std::string demo = make_schema_demo();
+    auto cache = std::make_shared<SchemaCache>();
+
+    constexpr size_t COUNT = 8;
+    std::vector<std::unique_ptr<Client>> clients;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        clients.emplace_back(std::make_unique<Client>());
+        clients.back()->set_schema_cache(cache);
+    }
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        threads.emplace_back([&demo, &client = *clients[i]]() { parse_schema(client, demo); });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Every client shares the one schema that was built
+    EXPECT_EQ(cache->size(), 1);
+    EXPECT_EQ(cache->statistics().misses, 1);
+    EXPECT_EQ(cache->statistics().hits, COUNT - 1);
+    for (const std::unique_ptr<Client>& client : clients)
+    {
+        EXPECT_TRUE(client->schema() == clients[0]->schema());
+        EXPECT_TRUE(client->server_classes().at(0)->data_table->type() == clients[0]->server_classes().at(0)->data_table->type());
+    }
+}
+
+TEST(SchemaCache, failed_build)
+{
+    SchemaCache cache;
+    EXPECT_THROW(
+        (void)cache.get(1, false, [](Schema&, const auto*) { throw SchemaCacheError("failed"); }),
+        SchemaCacheError);
+    EXPECT_EQ(cache.size(), 0);
+
+    bool built = false;
+    std::shared_ptr<const Schema> schema = cache.get(1, false, [&built](Schema&, const auto*) { built = true; });
+    EXPECT_TRUE(built);
+    EXPECT_EQ(schema->hash, 1);
+    EXPECT_EQ(cache.size(), 1);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.statistics().misses, 0);
+}
+
+TEST(SchemaCache, lazy_types)
+{
+    std::string demo = make_schema_demo();
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "csgopp_schema_cache_lazy";
+    std::filesystem::remove_all(directory);
+    auto cache = std::make_shared<SchemaCache>(directory);
+
+    Client lazy;
+    lazy.set_lazy_types(true);
+    lazy.set_schema_cache(cache);
+    parse_schema(lazy, demo);
+    EXPECT_EQ(lazy.server_classes().at(0)->type(), nullptr);
+    EXPECT_EQ(lazy.server_classes().at(1)->type(), nullptr);
+
+    // Incomplete schemas don't save their orders
+    EXPECT_TRUE(std::filesystem::is_empty(directory));
+
+    // Types are constructed as they're needed
+    (void)lazy.track_columns("CPlayer", {"m_iHealth"});
+    EXPECT_NE(lazy.server_classes().at(0)->type(), nullptr);
+    EXPECT_EQ(lazy.server_classes().at(1)->type(), nullptr);
+
+    // Eager clients finish the shared schema
+    Client eager;
+    eager.set_schema_cache(cache);
+    parse_schema(eager, demo);
+    EXPECT_EQ(cache->statistics().hits, 1);
+    EXPECT_NE(eager.server_classes().at(1)->type(), nullptr);
+    EXPECT_TRUE(eager.server_classes().at(0)->type() == lazy.server_classes().at(0)->type());
+    EXPECT_EQ(prioritized_names(eager), (std::vector<std::string>{"m_iArmor", "m_iAccount", "m_iHealth"}));
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/client/data_table.h>
+#include <csgopp/client/entity.h>
+#include <csgopp/client/server_class.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "entity_builder.h"
+
+using csgo::message::net::CSVCMsg_SendTable;
+using csgo::message::net::CSVCMsg_SendTable_sendprop_t;
+using csgopp::client::data_table::DataTable;
+using csgopp::client::data_table::property::Property;
+using csgopp::client::server_class::construct_types;
+using csgopp::client::server_class::ServerClass;
+using csgopp::common::database::Database;
+using csgopp::error::GameError;
+using entity_builder::make_send_prop;
+
+static std::shared_ptr<DataTable> make_construction_table(const std::string& name, const std::vector<std::string>& properties)
+{
+    CSVCMsg_SendTable send_table;
+    send_table.set_net_table_name(name);
+    auto data_table = std::make_shared<DataTable>(send_table);
+    for (size_t i = 0; i < properties.size(); ++i)
+    {
+        CSVCMsg_SendTable_sendprop_t data = make_send_prop(Property::Kind::INT32, properties[i]);
+        data.set_priority(static_cast<uint32_t>(properties.size() - i));
+        data_table->properties.emplace(std::make_shared<DataTable::Int32Property>(std::move(data)));
+    }
+    return data_table;
+}
+
+static void add_table_property(DataTable& data_table, const std::string& name, std::shared_ptr<DataTable> child)
+{
+    data_table.properties.emplace(std::make_shared<DataTable::DataTableProperty>(
+        make_send_prop(Property::Kind::DATA_TABLE, name), std::move(child)));
+}
+
+static std::shared_ptr<ServerClass> add_server_class(
+    Database<ServerClass>& server_classes,
+    const std::string& name,
+    const std::shared_ptr<DataTable>& data_table,
+    const std::shared_ptr<ServerClass>& base_class
+)
+{
+    auto server_class = std::make_shared<ServerClass>();
+    server_class->index = static_cast<ServerClass::Index>(server_classes.size());
+    server_class->name = name;
+    server_class->data_table = data_table;
+    server_class->base_class = base_class;
+    data_table->server_class = server_class;
+    server_classes.emplace(server_class);
+    return server_class;
+}
+
+/// A small hierarchy with a shared base class, a nested table and an array
+static Database<ServerClass> make_construction_schema()
+{
+    Database<ServerClass> server_classes;
+
+    auto base = make_construction_table("DT_BaseEntity", {"m_iTeamNum", "m_fFlags"});
+    auto base_class = add_server_class(server_classes, "CBaseEntity", base, nullptr);
+
+    auto ammo = make_construction_table("m_iAmmo", {"000", "001", "002"});
+    ammo->is_array = true;
+    auto local = make_construction_table("DT_Local", {"m_iFOV", "m_flFallVelocity"});
+    add_table_property(*local, "m_iAmmo", ammo);
+
+    auto player = make_construction_table("DT_Player", {"m_iHealth", "m_iArmor"});
+    add_table_property(*player, "baseclass", base);
+    add_table_property(*player, "localdata", local);
+    auto player_class = add_server_class(server_classes, "CPlayer", player, base_class);
+
+    auto bot = make_construction_table("DT_Bot", {"m_iDifficulty"});
+    add_table_property(*bot, "baseclass", player);
+    add_server_class(server_classes, "CBot", bot, player_class);
+
+    auto world = make_construction_table("DT_World", {"m_iRound"});
+    add_table_property(*world, "baseclass", base);
+    add_server_class(server_classes, "CWorld", world, base_class);
+
+    return server_classes;
+}
+
+static std::vector<std::string> construction_names(const ServerClass& server_class)
+{
+    std::vector<std::string> names;
+    for (const auto& datum : server_class.type()->prioritized)
+    {
+        names.push_back(datum.qualified_name() + "@" + std::to_string(datum.offset));
+    }
+    return names;
+}
+
+TEST(ServerClass, construct_types)
+{
+    Database<ServerClass> serial = make_construction_schema();
+    construct_types(serial);
+
+    for (size_t threads : {0, 2, 4})
+    {
+        Database<ServerClass> parallel = make_construction_schema();
+        construct_types(parallel, nullptr, threads);
+
+        ASSERT_EQ(parallel.size(), serial.size());
+        for (size_t i = 0; i < serial.size(); ++i)
+        {
+            ASSERT_NE(parallel.at(i)->type(), nullptr);
+            EXPECT_EQ(parallel.at(i)->type()->size(), serial.at(i)->type()->size());
+            EXPECT_EQ(construction_names(*parallel.at(i)), construction_names(*serial.at(i)));
+        }
+
+        // Derived types embed the very base type that was constructed
+        EXPECT_TRUE(parallel.at(2)->type()->base == parallel.at(1)->type().get());
+    }
+}
+
+TEST(ServerClass, construct_type_once)
+{
+    Database<ServerClass> server_classes = make_construction_schema();
+
+    // Racing to construct derived types builds each shared one once
+    std::vector<std::thread> threads;
+    std::vector<std::shared_ptr<const csgopp::client::entity::EntityType>> types(8);
+    for (size_t i = 0; i < types.size(); ++i)
+    {
+        threads.emplace_back([&server_classes, &types, i]()
+        {
+            types[i] = server_classes.at(1 + i % 3)->data_table->construct_type();
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < types.size(); ++i)
+    {
+        EXPECT_TRUE(types[i] == server_classes.at(1 + i % 3)->type());
+    }
+    EXPECT_TRUE(server_classes.at(2)->type()->base == server_classes.at(1)->type().get());
+    EXPECT_TRUE(server_classes.at(1)->type()->base == server_classes.at(0)->type().get());
+}
+
+TEST(ServerClass, construct_types_cycle)
+{
+    Database<ServerClass> server_classes;
+    auto first = make_construction_table("DT_First", {"m_iFirst"});
+    auto second = make_construction_table("DT_Second", {"m_iSecond"});
+    add_table_property(*first, "m_second", second);
+    add_table_property(*second, "m_first", first);
+    add_server_class(server_classes, "CFirst", first, nullptr);
+
+    EXPECT_THROW(construct_types(server_classes, nullptr, 2), GameError);
+}
@@ -2,6 +2,8 @@
 
 #include "csgopp/common/bits.h"
 
+#include <random>
+
 using namespace csgopp::common::bits;
 
 using Decoder = BitDecoder<BitView>;
@@ -161,3 +163,191 @@ TEST(Decoder, deserialize_variable_size_max_bad)
     EXPECT_TRUE(reader.read_variable_unsigned_int(&value));
     EXPECT_EQ(value, std::numeric_limits<uint32_t>::max());
 }
+
+TEST(Decoder, wide)
+{
+    std::vector<uint8_t> data{0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0xFF};
+    Decoder stream(data);
+    uint64_t value;
+    EXPECT_TRUE(stream.read(&value, 64));
+    EXPECT_EQ(value, 0xEFCDAB8967452301);
+
+    // Every width at every offset, including those crossing the tail
+    for (size_t offset = 0; offset < 8; ++offset)
+    {
+        for (size_t bits = 0; bits <= 64 && offset + bits <= 72; ++bits)
+        {
+            stream.reset();
+            EXPECT_TRUE(stream.skip(offset));
+            EXPECT_TRUE(stream.read(&value, bits));
+
+            uint64_t expected = 0;
+            for (size_t i = 0; i < bits; ++i)
+            {
+                size_t bit = offset + i;
+                expected |= static_cast<uint64_t>((data[bit / 8] >> (bit % 8)) & 1) << i;
+            }
+            EXPECT_EQ(value, expected) << "offset " << offset << ", bits " << bits;
+            EXPECT_EQ(stream.tell(), offset + bits);
+        }
+    }
+}
+
+TEST(Decoder, tail)
+{
+    std::vector<uint8_t> data{0xAB, 0xCD, 0xEF};
+    Decoder stream(data);
+    uint32_t value;
+    EXPECT_TRUE(stream.skip(4));
+    EXPECT_TRUE(stream.read(&value, 20));
+    EXPECT_EQ(value, 0xEFCDA);
+    EXPECT_EQ(stream.remaining(), 0);
+    EXPECT_TRUE(stream.read(&value, 0));
+    EXPECT_FALSE(stream.read(&value, 1));
+    EXPECT_TRUE(stream.skip(0));
+    EXPECT_FALSE(stream.skip(1));
+}
+
+static std::vector<uint8_t> shift_bytes(const std::string& string, size_t offset)
+{
+    std::vector<uint8_t> data((offset + string.size() * 8 + 7) / 8, 0);
+    for (size_t i = 0; i < string.size() * 8; ++i)
+    {
+        size_t bit = offset + i;
+        data[bit / 8] |= ((static_cast<uint8_t>(string[i / 8]) >> (i % 8)) & 1) << (bit % 8);
+    }
+    return data;
+}
+
+TEST(Decoder, string_blocks)
+{
+    std::string text;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        text.push_back(static_cast<char>('a' + i % 26));
+    }
+
+    // Lengths around the block size at every bit offset
+    for (size_t length : {0, 1, 7, 8, 31, 32, 33, 64, 65, 99})
+    {
+        for (size_t offset = 0; offset < 8; ++offset)
+        {
+            std::string payload = text.substr(0, length) + '\0' + "tai" + '\0';
+            std::vector<uint8_t> data = shift_bytes(payload, offset);
+            Decoder stream(data);
+            EXPECT_TRUE(stream.skip(offset));
+
+            std::string value;
+            EXPECT_TRUE(stream.read_string(value));
+            EXPECT_EQ(value, text.substr(0, length)) << "length " << length << ", offset " << offset;
+            EXPECT_EQ(stream.tell(), offset + (length + 1) * 8);
+
+            value.clear();
+            EXPECT_TRUE(stream.read_string(value));
+            EXPECT_EQ(value, "tai");
+        }
+    }
+}
+
+TEST(Decoder, string_blocks_unterminated)
+{
+    std::vector<uint8_t> data = shift_bytes(std::string(50, 'x'), 3);
+    Decoder stream(data);
+    EXPECT_TRUE(stream.skip(3));
+    std::string value;
+    EXPECT_FALSE(stream.read_string(value));
+    EXPECT_EQ(value, std::string(50, 'x'));
+}
+
+TEST(Decoder, string_from)
+{
+    std::string payload = std::string(40, 'y') + '\0' + std::string(19, 'z') + "abc";
+    for (size_t offset = 0; offset < 8; ++offset)
+    {
+        std::vector<uint8_t> data = shift_bytes(payload, offset);
+        Decoder stream(data);
+        EXPECT_TRUE(stream.skip(offset));
+
+        // The terminator comes first; the rest of the field is skipped
+        std::string value;
+        EXPECT_TRUE(stream.read_string_from(value, 60));
+        EXPECT_EQ(value, std::string(40, 'y'));
+        EXPECT_EQ(stream.tell(), offset + 60 * 8);
+
+        // The field ends before any terminator
+        EXPECT_TRUE(stream.read_string_from(value, 2));
+        EXPECT_EQ(value, "ab");
+        EXPECT_FALSE(stream.read_string_from(value, 2));
+    }
+}
+
+TEST(Decoder, string_from_buffer)
+{
+    std::string payload = std::string(40, 'y') + '\0' + std::string(19, 'z') + "abc";
+    for (size_t offset = 0; offset < 8; ++offset)
+    {
+        std::vector<uint8_t> data = shift_bytes(payload, offset);
+        Decoder stream(data);
+        EXPECT_TRUE(stream.skip(offset));
+
+        char buffer[64];
+        size_t length;
+        EXPECT_TRUE(stream.read_string_from(buffer, 60, &length));
+        EXPECT_EQ(std::string(buffer, length), std::string(40, 'y'));
+        EXPECT_EQ(stream.tell(), offset + 60 * 8);
+
+        EXPECT_TRUE(stream.read_string_from(buffer, 2, &length));
+        EXPECT_EQ(std::string(buffer, length), "ab");
+        EXPECT_FALSE(stream.read_string_from(buffer, 2, &length));
+    }
+}
+
+TEST(Decoder, property_jump)
+{
+    std::mt19937 generator(7);
+    std::string data(4096, '\0');
+    for (char& byte : data)
+    {
+        byte = static_cast<char>(generator());
+    }
+
+    for (bool small_increment : {false, true})
+    {
+        Decoder expected(data);
+        Decoder actual(data);
+        while (expected.remaining() >= 16)
+        {
+            // Mirror the separate reads the jump replaces
+            uint16_t expected_jump = 0;
+            uint8_t use_auto_index = 0;
+            uint8_t is_small_jump = 0;
+            if (small_increment)
+            {
+                EXPECT_TRUE(expected.read(&use_auto_index, 1));
+                if (!use_auto_index)
+                {
+                    EXPECT_TRUE(expected.read(&is_small_jump, 1));
+                }
+            }
+
+            if (is_small_jump)
+            {
+                EXPECT_TRUE(expected.read(&expected_jump, 3));
+            }
+            else if (!use_auto_index)
+            {
+                EXPECT_TRUE(expected.read_compressed_uint16(&expected_jump));
+            }
+
+            uint16_t actual_jump;
+            EXPECT_TRUE(actual.read_property_jump(small_increment, &actual_jump));
+            EXPECT_EQ(actual_jump, expected_jump);
+            EXPECT_EQ(actual.tell(), expected.tell());
+        }
+    }
+
+    std::string tail("\x00", 1);
+    Decoder truncated(tail);
+    uint16_t jump;
+    EXPECT_FALSE(truncated.read_property_jump(true, &jump));
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/common/compression.h>
+#include <csgopp/file.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <bzlib.h>
+#include <zlib.h>
+#include <zstd.h>
+
+#include "test_files.h"
+
+using namespace csgopp::common::compression;
+using csgopp::common::read_ahead::ReadAheadInputStream;
+using google::protobuf::io::CodedInputStream;
+using test_files::make_data;
+using test_files::write_temporary;
+
+static std::string gzip(const std::string& data)
+{
+    z_stream stream{};
+    EXPECT_EQ(deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY), Z_OK);
+    std::string result(deflateBound(&stream, data.size()) + 32, 0);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(result.data());
+    stream.avail_out = static_cast<uInt>(result.size());
+    EXPECT_EQ(deflate(&stream, Z_FINISH), Z_STREAM_END);
+    result.resize(stream.total_out);
+    deflateEnd(&stream);
+    return result;
+}
+
+static std::string zstd(const std::string& data)
+{
+    std::string result(ZSTD_compressBound(data.size()), 0);
+    size_t size = ZSTD_compress(result.data(), result.size(), data.data(), data.size(), 3);
+    EXPECT_FALSE(ZSTD_isError(size));
+    result.resize(size);
+    return result;
+}
+
+static std::string bzip2(const std::string& data)
+{
+    std::string result(data.size() + data.size() / 100 + 600, 0);
+    auto size = static_cast<unsigned int>(result.size());
+    EXPECT_EQ(BZ2_bzBuffToBuffCompress(
+        result.data(), &size,
+        const_cast<char*>(data.data()), static_cast<unsigned int>(data.size()),
+        9, 0, 0), BZ_OK);
+    result.resize(size);
+    return result;
+}
+
+class ChunkedSource final : public Source
+{
+public:
+    explicit ChunkedSource(std::string data) : _data(std::move(data)) {}
+
+    size_t read(char* buffer, size_t size) override
+    {
+        size_t count = std::min({size, this->_data.size() - this->_position, size_t(777)});
+        std::memcpy(buffer, this->_data.data() + this->_position, count);
+        this->_position += count;
+        return count;
+    }
+
+private:
+    std::string _data;
+    size_t _position{0};
+};
+
+static std::string drain(std::string compressed, Format format)
+{
+    ReadAheadInputStream stream(decompress(std::make_unique<ChunkedSource>(std::move(compressed)), format), 4096, 2);
+    std::string result;
+    const void* data;
+    int size;
+    while (stream.Next(&data, &size))
+    {
+        result.append(static_cast<const char*>(data), size);
+    }
+    return result;
+}
+
+TEST(Compression, detect)
+{
+    EXPECT_EQ(detect(gzip("x").data(), 4), Format::GZIP);
+    EXPECT_EQ(detect(zstd("x").data(), 4), Format::ZSTD);
+    EXPECT_EQ(detect(bzip2("x").data(), 4), Format::BZIP2);
+    EXPECT_EQ(detect("HL2DEMO", 8), Format::NONE);
+    EXPECT_EQ(detect("\x1F", 1), Format::NONE);
+    EXPECT_STREQ(describe_format(Format::ZSTD), "zstd");
+}
+
+TEST(Compression, round_trip)
+{
+    std::string data = make_data(300000);
+    EXPECT_EQ(drain(gzip(data), Format::GZIP), data);
+    EXPECT_EQ(drain(zstd(data), Format::ZSTD), data);
+    EXPECT_EQ(drain(bzip2(data), Format::BZIP2), data);
+    EXPECT_EQ(drain(data, Format::NONE), data);
+}
+
+TEST(Compression, concatenated)
+{
+    std::string first = make_data(5000);
+    std::string second = make_data(7000);
+    EXPECT_EQ(drain(gzip(first) + gzip(second), Format::GZIP), first + second);
+    EXPECT_EQ(drain(zstd(first) + zstd(second), Format::ZSTD), first + second);
+    EXPECT_EQ(drain(bzip2(first) + bzip2(second), Format::BZIP2), first + second);
+}
+
+TEST(Compression, truncated)
+{
+    std::string data = make_data(100000);
+    for (auto [compressed, format] : {
+        std::pair{gzip(data), Format::GZIP},
+        std::pair{zstd(data), Format::ZSTD},
+        std::pair{bzip2(data), Format::BZIP2}})
+    {
+        compressed.resize(compressed.size() / 2);
+        EXPECT_THROW(drain(compressed, format), CompressionError) << describe_format(format);
+    }
+}
+
+TEST(Compression, open)
+{
+    std::string data = make_data(50000);
+    std::filesystem::path path = write_temporary("csgopp_compression.dem.zst", zstd(data));
+
+    std::string result;
+    {
+        auto input = csgopp::file::open(path);
+        CodedInputStream stream(input.get());
+        EXPECT_TRUE(stream.ReadString(&result, 50000));
+        EXPECT_FALSE(stream.Skip(1));
+    }
+
+    EXPECT_EQ(result, data);
+    std::filesystem::remove(path);
+}
+
+TEST(Compression, estimate_size)
+{
+    std::string data = make_data(50000);
+    std::filesystem::path path;
+    auto estimate = [&path](const std::string& contents)
+    {
+        path = write_temporary("csgopp_compression_estimate.dem", contents);
+        return estimate_size(path);
+    };
+
+    EXPECT_EQ(estimate(data), data.size());
+    EXPECT_EQ(estimate(gzip(data)), data.size());
+    EXPECT_EQ(estimate(zstd(data)), data.size());
+    std::string compressed = bzip2(data);
+    EXPECT_EQ(estimate(compressed), compressed.size() * ESTIMATED_RATIO);
+
+    std::filesystem::remove(path);
+    EXPECT_THROW((void)estimate_size(path), std::filesystem::filesystem_error);
+}
@@ -0,0 +1,17 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/common/hash.h>
+
+using namespace csgopp::common::hash;
+
+TEST(Hash, fnv1a)
+{
+    EXPECT_EQ(fnv1a(""), 0xCBF29CE484222325);
+    EXPECT_EQ(fnv1a("a"), 0xAF63DC4C8601EC8C);
+}
+
+TEST(Hash, fnv1a_seed)
+{
+    EXPECT_EQ(fnv1a("def", fnv1a("abc")), fnv1a("abcdef"));
+    EXPECT_NE(fnv1a("abc", fnv1a("def")), fnv1a("abcdef"));
+}
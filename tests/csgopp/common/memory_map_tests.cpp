@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/common/memory_map.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <filesystem>
+#include <string>
+
+#include "test_files.h"
+
+using namespace csgopp::common::memory_map;
+using google::protobuf::io::CodedInputStream;
+using test_files::write_temporary;
+
+TEST(MemoryMap, next_back_up)
+{
+    std::filesystem::path path = write_temporary("csgopp_memory_map_next.bin", "hello world");
+    MemoryMappedInputStream stream(path);
+
+    const void* data;
+    int size;
+    EXPECT_TRUE(stream.Next(&data, &size));
+    EXPECT_EQ(size, 11);
+    EXPECT_EQ(std::string(static_cast<const char*>(data), size), "hello world");
+
+    stream.BackUp(5);
+    EXPECT_EQ(stream.ByteCount(), 6);
+    EXPECT_TRUE(stream.Next(&data, &size));
+    EXPECT_EQ(std::string(static_cast<const char*>(data), size), "world");
+    EXPECT_FALSE(stream.Next(&data, &size));
+
+    std::filesystem::remove(path);
+}
+
+TEST(MemoryMap, skip)
+{
+    std::filesystem::path path = write_temporary("csgopp_memory_map_skip.bin", "hello world");
+    MemoryMappedInputStream stream(path);
+    EXPECT_TRUE(stream.Skip(6));
+    EXPECT_EQ(stream.ByteCount(), 6);
+    EXPECT_FALSE(stream.Skip(6));
+    EXPECT_EQ(stream.ByteCount(), 11);
+
+    std::filesystem::remove(path);
+}
+
+TEST(MemoryMap, coded)
+{
+    std::string data("\x2a\x00\x00\x00\x05hello", 10);
+    std::filesystem::path path = write_temporary("csgopp_memory_map_coded.bin", data);
+    MemoryMappedInputStream stream(path);
+    {
+        CodedInputStream coded(&stream);
+        uint32_t value;
+        EXPECT_TRUE(coded.ReadLittleEndian32(&value));
+        EXPECT_EQ(value, 42);
+        std::string string;
+        EXPECT_TRUE(coded.ReadVarint32(&value));
+        EXPECT_TRUE(coded.ReadString(&string, static_cast<int>(value)));
+        EXPECT_EQ(string, "hello");
+    }
+    EXPECT_EQ(stream.ByteCount(), 10);
+
+    std::filesystem::remove(path);
+}
+
+TEST(MemoryMap, empty)
+{
+    std::filesystem::path path = write_temporary("csgopp_memory_map_empty.bin", "");
+    MemoryMappedInputStream stream(path);
+    const void* data;
+    int size;
+    EXPECT_FALSE(stream.Next(&data, &size));
+
+    std::filesystem::remove(path);
+}
+
+TEST(MemoryMap, missing)
+{
+    EXPECT_THROW(MemoryMappedInputStream("csgopp_memory_map_missing.bin"), MemoryMapError);
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/common/pool.h>
+#include <atomic>
+
+using namespace csgopp::common::pool;
+
+TEST(Pool, submit_wait)
+{
+    std::atomic<int> count{0};
+    Pool pool(4);
+    for (int i = 0; i < 1000; ++i)
+    {
+        pool.submit([&count]() { count += 1; });
+    }
+    pool.wait();
+    EXPECT_EQ(count, 1000);
+}
+
+TEST(Pool, nested)
+{
+    std::atomic<int> count{0};
+    Pool pool(3);
+    for (int i = 0; i < 10; ++i)
+    {
+        pool.submit([&pool, &count]()
+        {
+            for (int j = 0; j < 10; ++j)
+            {
+                pool.submit([&count]() { count += 1; });
+            }
+        });
+    }
+    pool.wait();
+    EXPECT_EQ(count, 100);
+}
+
+TEST(Pool, budget)
+{
+    Budget budget(10);
+    EXPECT_EQ(budget.acquire(4), 4);
+    EXPECT_EQ(budget.acquire(6), 6);
+    budget.release(10);
+    EXPECT_EQ(budget.acquire(100), 10);
+    budget.release(10);
+}
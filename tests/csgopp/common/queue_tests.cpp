@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/common/queue.h>
+#include <thread>
+
+using namespace csgopp::common::queue;
+
+TEST(Queue, push_pop)
+{
+    Queue<int> queue(2);
+    EXPECT_EQ(queue.capacity(), 2);
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_TRUE(queue.try_push(2));
+    EXPECT_FALSE(queue.try_push(3));
+    EXPECT_EQ(queue.size(), 2);
+
+    int value;
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(queue.try_push(3));
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST(Queue, threads)
+{
+    constexpr int COUNT = 20000;
+    Queue<int> queue(16);
+    std::thread producer([&queue]()
+    {
+        for (int i = 0; i < COUNT; ++i)
+        {
+            while (!queue.try_push(int(i)))
+            {
+                uint32_t seen = queue.consumed.load();
+                if (queue.try_push(int(i)))
+                {
+                    break;
+                }
+                queue.consumed.wait(seen);
+            }
+        }
+    });
+
+    int expected = 0;
+    while (expected < COUNT)
+    {
+        int value;
+        uint32_t seen = queue.produced.load();
+        if (queue.try_pop(value))
+        {
+            ASSERT_EQ(value, expected);
+            expected += 1;
+        }
+        else
+        {
+            queue.produced.wait(seen);
+        }
+    }
+
+    producer.join();
+}
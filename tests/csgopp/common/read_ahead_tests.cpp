@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/common/read_ahead.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#include "test_files.h"
+
+using namespace csgopp::common::read_ahead;
+using google::protobuf::io::CodedInputStream;
+using test_files::make_data;
+using test_files::write_temporary;
+
+class StringSource final : public Source
+{
+public:
+    explicit StringSource(std::string data, size_t fail_at = std::string::npos)
+        : _data(std::move(data)), _fail_at(fail_at)
+    {
+    }
+
+    size_t read(char* buffer, size_t size) override
+    {
+        if (this->_position >= this->_fail_at)
+        {
+            throw ReadAheadError("source failed");
+        }
+
+        size_t count = std::min({size, this->_data.size() - this->_position, size_t(1000)});
+        std::memcpy(buffer, this->_data.data() + this->_position, count);
+        this->_position += count;
+        return count;
+    }
+
+private:
+    std::string _data;
+    size_t _fail_at;
+    size_t _position{0};
+};
+
+TEST(ReadAhead, file)
+{
+    std::string data = make_data(100000);
+    std::filesystem::path path = write_temporary("csgopp_read_ahead.bin", data);
+
+    ReadAheadInputStream stream(std::make_unique<FileSource>(path), 4096, 3);
+    std::string result;
+    {
+        CodedInputStream coded(&stream);
+        EXPECT_TRUE(coded.ReadString(&result, 50000));
+        EXPECT_TRUE(coded.Skip(10000));
+        std::string rest;
+        EXPECT_TRUE(coded.ReadString(&rest, 40000));
+        EXPECT_FALSE(coded.Skip(1));
+        result += std::string(10000, 0) + rest;
+    }
+
+    EXPECT_EQ(result.substr(0, 50000), data.substr(0, 50000));
+    EXPECT_EQ(result.substr(60000), data.substr(60000));
+    EXPECT_EQ(stream.ByteCount(), 100000);
+    EXPECT_EQ(stream.statistics().buffer_size, 4096);
+    EXPECT_EQ(stream.statistics().depth, 3);
+
+    std::filesystem::remove(path);
+}
+
+TEST(ReadAhead, back_up)
+{
+    ReadAheadInputStream stream(std::make_unique<StringSource>("hello world"), 8, 2);
+    const void* data;
+    int size;
+    EXPECT_TRUE(stream.Next(&data, &size));
+    EXPECT_EQ(std::string(static_cast<const char*>(data), size), "hello wo");
+    stream.BackUp(2);
+    EXPECT_EQ(stream.ByteCount(), 6);
+    EXPECT_TRUE(stream.Next(&data, &size));
+    EXPECT_EQ(std::string(static_cast<const char*>(data), size), "wo");
+    EXPECT_TRUE(stream.Next(&data, &size));
+    EXPECT_EQ(std::string(static_cast<const char*>(data), size), "rld");
+    EXPECT_FALSE(stream.Next(&data, &size));
+}
+
+TEST(ReadAhead, error)
+{
+    ReadAheadInputStream stream(std::make_unique<StringSource>(make_data(10000), 5000), 1024, 2);
+    EXPECT_TRUE(stream.Skip(4096));
+    EXPECT_THROW(stream.Skip(4096), ReadAheadError);
+}
+
+TEST(ReadAhead, early_destruction)
+{
+    ReadAheadInputStream stream(std::make_unique<StringSource>(make_data(100000)), 1024, 2);
+    const void* data;
+    int size;
+    EXPECT_TRUE(stream.Next(&data, &size));
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/demo/frame_index.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <filesystem>
+#include <string>
+
+#include "demo_builder.h"
+
+using namespace csgopp::demo::frame_index;
+using demo_builder::append_frame;
+using google::protobuf::io::ArrayInputStream;
+
+static std::string make_demo()
+{
+    std::string demo;
+    append_frame(demo, Command::SIGN_ON, 0, "abc");
+    append_frame(demo, Command::DATA_TABLES, 0, "tables");
+    append_frame(demo, Command::SYNC_TICK, 1, "");
+    append_frame(demo, Command::PACKET, 2, "packet");
+    append_frame(demo, Command::USER_COMMAND, 2, "user");
+    append_frame(demo, Command::PACKET, 4, "another");
+    append_frame(demo, Command::STOP, 5, "");
+    return demo;
+}
+
+TEST(FrameIndex, scan)
+{
+    std::string demo = make_demo();
+    ArrayInputStream input(demo.data(), static_cast<int>(demo.size()));
+    CodedInputStream stream(&input);
+    FrameIndex index = FrameIndex::scan(stream);
+
+    ASSERT_EQ(index.size(), 7);
+    EXPECT_EQ(index.frames()[0].offset, 0);
+    EXPECT_EQ(index.frames()[0].size, 3);
+    EXPECT_EQ(index.frames().back().command, Command::STOP);
+
+    const Frame* data_tables = index.find(Command::DATA_TABLES);
+    ASSERT_NE(data_tables, nullptr);
+    EXPECT_EQ(demo.substr(data_tables->payload(), data_tables->size), "tables");
+
+    auto packet = index.at(3);
+    ASSERT_NE(packet, index.frames().end());
+    EXPECT_EQ(packet->tick, 4);
+    EXPECT_EQ(demo.substr(packet->payload(), packet->size), "another");
+
+    const Frame* user = index.find(Command::USER_COMMAND);
+    ASSERT_NE(user, nullptr);
+    EXPECT_EQ(demo.substr(user->payload(), user->size), "user");
+
+    EXPECT_EQ(index.at(6), index.frames().end());
+    EXPECT_EQ(index.find(Command::STRING_TABLES), nullptr);
+}
+
+TEST(FrameIndex, save_load)
+{
+    std::string demo = make_demo();
+    ArrayInputStream input(demo.data(), static_cast<int>(demo.size()));
+    CodedInputStream stream(&input);
+    FrameIndex index = FrameIndex::scan(stream);
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "csgopp_frame_index.index";
+    index.save(path);
+    FrameIndex loaded = FrameIndex::load(path);
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(loaded.size(), index.size());
+    for (size_t i = 0; i < index.size(); ++i)
+    {
+        EXPECT_EQ(loaded.frames()[i].offset, index.frames()[i].offset);
+        EXPECT_EQ(loaded.frames()[i].tick, index.frames()[i].tick);
+        EXPECT_EQ(loaded.frames()[i].size, index.frames()[i].size);
+        EXPECT_EQ(loaded.frames()[i].command, index.frames()[i].command);
+    }
+}
+
+TEST(FrameIndex, truncated)
+{
+    std::string demo = make_demo();
+    demo.resize(demo.size() - 20);
+    ArrayInputStream input(demo.data(), static_cast<int>(demo.size()));
+    CodedInputStream stream(&input);
+    EXPECT_THROW(FrameIndex::scan(stream), csgopp::error::GameError);
+}
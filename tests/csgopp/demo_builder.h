@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <google/protobuf/message_lite.h>
+
+#include <csgopp/demo.h>
+#include "netmessages.pb.h"
+
+/// Helpers for assembling synthetic demos byte by byte.
+namespace demo_builder
+{
+
+using csgopp::demo::Command;
+
+/// \brief Append a protobuf-style varint.
+inline void append_varint(std::string& data, uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        data.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<char>(value));
+}
+
+/// \brief Append a net message as its type, size and payload.
+inline void append_message(std::string& packet, uint32_t type, const std::string& payload)
+{
+    append_varint(packet, type);
+    append_varint(packet, static_cast<uint32_t>(payload.size()));
+    packet.append(payload);
+}
+
+inline void append_message(std::string& packet, uint32_t type, const google::protobuf::MessageLite& message)
+{
+    append_message(packet, type, message.SerializeAsString());
+}
+
+/// \brief Append a frame, including the command-specific fields.
+///
+/// Sign-on and packet frames get an empty 160 byte command info and user
+/// commands an outgoing sequence of zero. Sync tick and stop frames carry
+/// no payload, so `payload` is ignored for them.
+inline void append_frame(std::string& demo, Command::Type command, uint32_t tick, const std::string& payload)
+{
+    demo.push_back(static_cast<char>(command));
+    demo.append(reinterpret_cast<const char*>(&tick), 4);
+    demo.push_back(0);  // player slot
+
+    switch (command)
+    {
+        case Command::SIGN_ON:
+        case Command::PACKET:
+            demo.append(160, 0);
+            break;
+        case Command::USER_COMMAND:
+            demo.append(4, 0);
+            break;
+        default:
+            break;
+    }
+
+    if (command != Command::SYNC_TICK && command != Command::STOP)
+    {
+        auto size = static_cast<uint32_t>(payload.size());
+        demo.append(reinterpret_cast<const char*>(&size), 4);
+        demo.append(payload);
+    }
+}
+
+/// \brief Packs values least significant bit first, like `BitStream` reads.
+struct BitWriter
+{
+    std::string data;
+    size_t size{0};
+
+    void write(uint64_t value, size_t bits)
+    {
+        for (size_t i = 0; i < bits; ++i, ++this->size)
+        {
+            if (this->size % 8 == 0)
+            {
+                this->data.push_back(0);
+            }
+            if ((value >> i) & 1)
+            {
+                this->data.back() = static_cast<char>(this->data.back() | (1 << (this->size % 8)));
+            }
+        }
+    }
+
+    /// Write a string including its null terminator
+    void write_string(const std::string& string)
+    {
+        for (char c : string)
+        {
+            this->write(static_cast<uint8_t>(c), 8);
+        }
+        this->write(0, 8);
+    }
+};
+
+/// \brief Append a send table message of a `DATA_TABLES` frame.
+inline void append_send_table(std::string& data, const csgo::message::net::CSVCMsg_SendTable& send_table)
+{
+    append_message(data, csgo::message::net::SVC_Messages::svc_SendTable, send_table);
+}
+
+/// \brief Append a server class entry of a `DATA_TABLES` frame.
+inline void append_server_class(std::string& data, uint16_t index, const std::string& name, const std::string& table)
+{
+    data.append(reinterpret_cast<const char*>(&index), 2);
+    data.append(name.c_str(), name.size() + 1);
+    data.append(table.c_str(), table.size() + 1);
+}
+
+/// \brief Serialize a demo header as it is laid out on disk.
+inline std::string make_header(const csgopp::demo::Header& header)
+{
+    std::string data;
+    data.append(header.magic, 8);
+    data.append(reinterpret_cast<const char*>(&header.demo_protocol), 4);
+    data.append(reinterpret_cast<const char*>(&header.network_protocol), 4);
+    data.append(header.server_name, 260);
+    data.append(header.client_name, 260);
+    data.append(header.map_name, 260);
+    data.append(header.game_directory, 260);
+    data.append(reinterpret_cast<const char*>(&header.playback_time), 4);
+    data.append(reinterpret_cast<const char*>(&header.tick_count), 4);
+    data.append(reinterpret_cast<const char*>(&header.frame_count), 4);
+    data.append(reinterpret_cast<const char*>(&header.sign_on_size), 4);
+    return data;
+}
+
+/// \brief Serialize an otherwise empty header with the demo magic.
+inline std::string make_header()
+{
+    csgopp::demo::Header header;
+    std::memcpy(header.magic, "HL2DEMO", 8);
+    return make_header(header);
+}
+
+}
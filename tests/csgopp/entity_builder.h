@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <csgopp/client/data_table/property.h>
+#include <csgopp/client/entity.h>
+#include <object/object.h>
+#include "netmessages.pb.h"
+
+/// Helpers for building send tables and entity types without a demo.
+namespace entity_builder
+{
+
+using csgo::message::net::CSVCMsg_SendTable_sendprop_t;
+using csgopp::client::data_table::property::Property;
+using csgopp::client::entity::EntityType;
+using object::ObjectType;
+using object::Type;
+
+/// \brief Describe a send table property.
+inline CSVCMsg_SendTable_sendprop_t make_send_prop(
+    Property::Kind::T kind,
+    const std::string& name,
+    int32_t flags = 0,
+    int32_t bits = 32,
+    float low = 0,
+    float high = 0
+)
+{
+    CSVCMsg_SendTable_sendprop_t data;
+    data.set_type(kind);
+    data.set_var_name(name);
+    data.set_flags(flags);
+    data.set_num_bits(bits);
+    data.set_low_value(low);
+    data.set_high_value(high);
+    return data;
+}
+
+/// \brief Build and compile an entity type with the given members in order.
+inline std::shared_ptr<EntityType> make_entity_type(
+    std::initializer_list<std::pair<const char*, std::shared_ptr<const Type>>> members
+)
+{
+    ObjectType::Builder builder;
+    for (const auto& [name, type] : members)
+    {
+        builder.member(name, type);
+    }
+    auto type = std::make_shared<EntityType>(std::move(builder));
+    type->compile();
+    return type;
+}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <csgopp/client/data_table.h>
+#include <csgopp/client/entity.h>
+#include <csgopp/client/server_class.h>
+#include "entity_builder.h"
+#include "netmessages.pb.h"
+
+/// Small `DT_Player` and `DT_Weapon` tables and server classes for entity tests.
+namespace player_table
+{
+
+using csgo::message::net::CSVCMsg_SendTable;
+using csgopp::client::data_table::DataTable;
+using csgopp::client::data_table::property::Property;
+using csgopp::client::entity::EntityType;
+using csgopp::client::server_class::ServerClass;
+using entity_builder::make_send_prop;
+
+/// \brief Build `CPlayer` with `m_iHealth`, `m_vecOrigin` and `m_szName`.
+inline std::shared_ptr<ServerClass> make_server_class()
+{
+    CSVCMsg_SendTable send_table;
+    send_table.set_net_table_name("DT_Player");
+    auto data_table = std::make_shared<DataTable>(send_table);
+    data_table->properties.emplace(std::make_shared<DataTable::Int32Property>(make_send_prop(Property::Kind::INT32, "m_iHealth")));
+    data_table->properties.emplace(std::make_shared<DataTable::Vector3Property>(make_send_prop(Property::Kind::VECTOR3, "m_vecOrigin")));
+    data_table->properties.emplace(std::make_shared<DataTable::StringProperty>(make_send_prop(Property::Kind::STRING, "m_szName")));
+    data_table->construct_type();
+
+    auto server_class = std::make_shared<ServerClass>();
+    server_class->name = "CPlayer";
+    server_class->data_table = data_table;
+    return server_class;
+}
+
+/// \brief Build `CWeapon` with a single array property.
+///
+/// \tparam Element the property type of the array's elements.
+template<typename Element>
+inline std::shared_ptr<ServerClass> make_weapon_server_class(Property::Kind::T kind, const std::string& name, int32_t length)
+{
+    CSVCMsg_SendTable send_table;
+    send_table.set_net_table_name("DT_Weapon");
+    auto data_table = std::make_shared<DataTable>(send_table);
+    auto array = std::make_shared<DataTable::ArrayProperty>(
+        make_send_prop(Property::Kind::ARRAY, name),
+        std::make_unique<Element>(make_send_prop(kind, name)));
+    array->length = length;
+    data_table->properties.emplace(array);
+    data_table->construct_type();
+
+    auto server_class = std::make_shared<ServerClass>();
+    server_class->name = "CWeapon";
+    server_class->data_table = data_table;
+    return server_class;
+}
+
+/// \brief Find the prioritized index of a property by qualified name.
+inline uint16_t prioritized_index(const EntityType& type, const std::string& name)
+{
+    for (size_t i = 0; i < type.prioritized.size(); ++i)
+    {
+        if (type.prioritized[i].qualified_name() == name)
+        {
+            return static_cast<uint16_t>(i);
+        }
+    }
+    throw std::out_of_range(name);
+}
+
+}
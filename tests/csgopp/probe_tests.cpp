@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <csgopp/probe.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "demo_builder.h"
+
+using namespace csgopp::probe;
+using csgo::message::net::CSVCMsg_GameEventList;
+using csgo::message::net::SVC_Messages;
+using csgopp::demo::Command;
+using demo_builder::append_frame;
+using demo_builder::append_message;
+using google::protobuf::io::ArrayInputStream;
+
+static std::string make_header(uint32_t sign_on_size)
+{
+    csgopp::demo::Header header;
+    std::memcpy(header.magic, "HL2DEMO", 8);
+    std::strcpy(header.map_name, "de_dust2");
+    header.tick_count = 1000;
+    header.sign_on_size = sign_on_size;
+    return demo_builder::make_header(header);
+}
+
+static std::string make_sign_on()
+{
+    CSVCMsg_ServerInfo server_info;
+    server_info.set_map_name("de_dust2");
+    server_info.set_max_clients(10);
+    server_info.set_tick_interval(1.0f / 128);
+
+    CSVCMsg_GameEventList game_event_list;
+    auto* descriptor = game_event_list.add_descriptors();
+    descriptor->set_eventid(23);
+    descriptor->set_name("player_death");
+    auto* key = descriptor->add_keys();
+    key->set_type(4);
+    key->set_name("userid");
+
+    std::string packet;
+    append_message(packet, SVC_Messages::svc_ServerInfo, server_info);
+    append_message(packet, SVC_Messages::svc_GameEventList, game_event_list);
+
+    std::string sign_on;
+    append_frame(sign_on, Command::SIGN_ON, 0, packet);
+    // Data tables that would fail to parse, so they must be skipped
+    append_frame(sign_on, Command::DATA_TABLES, 0, std::string(64, '\xFF'));
+    return sign_on;
+}
+
+static std::string make_match()
+{
+    std::string packet;
+    append_message(packet, SVC_Messages::svc_CreateStringTable, std::string(16, '\xFF'));
+    std::string match;
+    append_frame(match, Command::PACKET, 0, packet);
+    append_frame(match, Command::STOP, 0, "");
+    return match;
+}
+
+static void check(const Probe& probe)
+{
+    EXPECT_STREQ(probe.header.map_name, "de_dust2");
+    EXPECT_EQ(probe.header.tick_count, 1000);
+    ASSERT_TRUE(probe.has_server_info);
+    EXPECT_EQ(probe.server_info.map_name(), "de_dust2");
+    EXPECT_EQ(probe.server_info.max_clients(), 10);
+    ASSERT_EQ(probe.game_event_types.size(), 1);
+    EXPECT_EQ(probe.game_event_types[0]->name, "player_death");
+    EXPECT_TRUE(probe.users.empty());
+}
+
+TEST(Probe, sign_on_size)
+{
+    std::string sign_on = make_sign_on();
+    std::string demo = make_header(static_cast<uint32_t>(sign_on.size())) + sign_on + make_match();
+    ArrayInputStream input(demo.data(), static_cast<int>(demo.size()));
+    CodedInputStream stream(&input);
+
+    Probe probe = csgopp::probe::probe(stream);
+    check(probe);
+    EXPECT_EQ(probe.frames, 2);
+    EXPECT_EQ(probe.bytes, sign_on.size());
+}
+
+TEST(Probe, sync_tick)
+{
+    std::string sign_on = make_sign_on();
+    append_frame(sign_on, Command::SYNC_TICK, 0, "");
+    std::string demo = make_header(0) + sign_on + make_match();
+    ArrayInputStream input(demo.data(), static_cast<int>(demo.size()));
+    CodedInputStream stream(&input);
+
+    Probe probe = csgopp::probe::probe(stream);
+    check(probe);
+    EXPECT_EQ(probe.frames, 3);
+    EXPECT_EQ(probe.bytes, sign_on.size());
+}
+
+TEST(Probe, file_ignores_pipeline)
+{
+    std::string sign_on = make_sign_on();
+    std::string demo = make_header(static_cast<uint32_t>(sign_on.size())) + sign_on + make_match();
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "csgopp_probe_pipeline.dem";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(demo.data(), static_cast<std::streamsize>(demo.size()));
+    }
+
+    csgopp::file::Options options;
+    options.pipeline = true;
+    Probe probe = csgopp::probe::probe(path, options);
+    check(probe);
+    EXPECT_EQ(probe.frames, 2);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/// Helpers for tests that read from files on disk.
+namespace test_files
+{
+
+/// \brief Write data to a file in the temporary directory.
+inline std::filesystem::path write_temporary(const std::string& name, const std::string& data)
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+    std::ofstream out(path, std::ios::binary);
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return path;
+}
+
+/// \brief Bytes that vary with position but still compress.
+inline std::string make_data(size_t size)
+{
+    std::string data(size, 0);
+    for (size_t i = 0; i < size; ++i)
+    {
+        data[i] = static_cast<char>((i % 97) * (i / 4096 + 1));
+    }
+    return data;
+}
+
+}